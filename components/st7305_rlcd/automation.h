@@ -0,0 +1,16 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "st7305_rlcd.h"
+
+namespace esphome {
+namespace st7305_rlcd {
+
+/// Runs the drawing and flush benchmark suite and logs the results
+template<typename... Ts> class BenchmarkAction : public Action<Ts...>, public Parented<ST7305RLCD> {
+ public:
+  void play(Ts... x) override { this->parent_->run_benchmark(); }
+};
+
+}  // namespace st7305_rlcd
+}  // namespace esphome
@@ -2,9 +2,20 @@
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome import pins
-from esphome.components import display, spi
+import esphome.final_validate as fv
+from esphome import automation, pins
+from esphome.components import (
+    binary_sensor,
+    display,
+    number,
+    select,
+    sensor,
+    spi,
+    switch,
+    text_sensor,
+)
 from esphome.const import (
+    CONF_AUTO_CLEAR_ENABLED,
     CONF_DC_PIN,
     CONF_ID,
     CONF_LAMBDA,
@@ -20,6 +31,39 @@ DEPENDENCIES = ["spi"]
 AUTO_LOAD = ["display"]
 
 CONF_ORIENTATION = "orientation"
+CONF_COL_START = "col_start"
+CONF_COL_END = "col_end"
+CONF_ROW_START = "row_start"
+CONF_ROW_END = "row_end"
+CONF_GATE_LINES = "gate_lines"
+CONF_VOLTAGES = "voltages"
+CONF_VSHP = "vshp"
+CONF_VSLP = "vslp"
+CONF_VSHN = "vshn"
+CONF_VSLN = "vsln"
+CONF_DITHER = "dither"
+CONF_VERIFY_DATA_RATE = "verify_data_rate"
+CONF_DIFF_UPDATES = "diff_updates"
+CONF_ASYNC_FLUSH = "async_flush"
+CONF_FLUSH_CHUNK_ROWS = "flush_chunk_rows"
+CONF_DOUBLE_BUFFER = "double_buffer"
+CONF_FRAME_MODULATION = "frame_modulation"
+CONF_SUBFRAME_INTERVAL = "subframe_interval"
+CONF_TE_PIN = "te_pin"
+CONF_PACED_UPDATES = "paced_updates"
+CONF_POWER_GOVERNOR = "power_governor"
+CONF_LOW_POWER_AFTER = "low_power_after"
+CONF_SLEEP_AFTER = "sleep_after"
+CONF_BENCHMARK = "benchmark"
+CONF_BUFFER_MEMORY = "buffer_memory"
+CONF_IRAM_HOT_PATH = "iram_hot_path"
+CONF_STRIP_ROWS = "strip_rows"
+CONF_SNAPSHOT = "snapshot"
+CONF_RESUME = "resume"
+CONF_BACKGROUND_LAMBDA = "background_lambda"
+CONF_RENDER_TASK = "render_task"
+CONF_CONTENT_HASH = "content_hash"
+CONF_WATCH = "watch"
 
 st7305_rlcd_ns = cg.esphome_ns.namespace("st7305_rlcd")
 ST7305RLCD = st7305_rlcd_ns.class_(
@@ -27,6 +71,7 @@ ST7305RLCD = st7305_rlcd_ns.class_(
     display.DisplayBuffer,
     spi.SPIDevice,
 )
+BenchmarkAction = st7305_rlcd_ns.class_("BenchmarkAction", automation.Action)
 
 ST7305Model = st7305_rlcd_ns.enum("ST7305Model")
 MODELS = {
@@ -35,12 +80,60 @@ MODELS = {
     "CUSTOM": ST7305Model.ST7305_MODEL_CUSTOM,
 }
 
+# Predefined models map to constexpr profiles; only the referenced one is compiled in
+PROFILES = {
+    "WAVESHARE_400X300": st7305_rlcd_ns.ST7305_PROFILE_WAVESHARE_400X300,
+    "OSPTEK_200X200": st7305_rlcd_ns.ST7305_PROFILE_OSPTEK_200X200,
+}
+
+CUSTOM_PANEL_KEYS = (
+    CONF_WIDTH,
+    CONF_HEIGHT,
+    CONF_ORIENTATION,
+    CONF_COL_START,
+    CONF_COL_END,
+    CONF_ROW_START,
+    CONF_ROW_END,
+    CONF_GATE_LINES,
+    CONF_VOLTAGES,
+)
+
+# Address window the C++ side keeps when a custom panel leaves a key out
+DEFAULT_COL_START = 0x12
+DEFAULT_COL_END = 0x2A
+DEFAULT_ROW_START = 0x00
+DEFAULT_ROW_END = 0xC7
+
 ST7305Orientation = st7305_rlcd_ns.enum("ST7305Orientation")
 ORIENTATIONS = {
     "LANDSCAPE": ST7305Orientation.ST7305_ORIENTATION_LANDSCAPE,
     "PORTRAIT": ST7305Orientation.ST7305_ORIENTATION_PORTRAIT,
 }
 
+ST7305BufferMemory = st7305_rlcd_ns.enum("ST7305BufferMemory")
+BUFFER_MEMORIES = {
+    "AUTO": ST7305BufferMemory.ST7305_BUFFER_MEMORY_AUTO,
+    "INTERNAL": ST7305BufferMemory.ST7305_BUFFER_MEMORY_INTERNAL,
+    "EXTERNAL": ST7305BufferMemory.ST7305_BUFFER_MEMORY_EXTERNAL,
+}
+
+ST7305DitherMode = st7305_rlcd_ns.enum("ST7305DitherMode")
+DITHER_MODES = {
+    "NONE": ST7305DitherMode.ST7305_DITHER_NONE,
+    "BAYER": ST7305DitherMode.ST7305_DITHER_BAYER,
+}
+
+
+# Entities whose state callbacks watch() can subscribe to
+WATCH_TYPES = (
+    sensor.Sensor,
+    binary_sensor.BinarySensor,
+    text_sensor.TextSensor,
+    switch.Switch,
+    number.Number,
+    select.Select,
+)
+
 
 def validate_custom_panel(config):
     """Validate that custom panels have required dimensions."""
@@ -53,6 +146,117 @@ def validate_custom_panel(config):
             raise cv.Invalid(
                 "Custom model requires 'orientation' (LANDSCAPE or PORTRAIT)"
             )
+        if config.get(CONF_COL_START, DEFAULT_COL_START) > config.get(
+            CONF_COL_END, DEFAULT_COL_END
+        ):
+            raise cv.Invalid("'col_start' must not be greater than 'col_end'")
+        if config.get(CONF_ROW_START, DEFAULT_ROW_START) > config.get(
+            CONF_ROW_END, DEFAULT_ROW_END
+        ):
+            raise cv.Invalid("'row_start' must not be greater than 'row_end'")
+    else:
+        for key in CUSTOM_PANEL_KEYS:
+            if key in config:
+                raise cv.Invalid(
+                    f"'{key}' is only supported with 'model: CUSTOM'", path=[key]
+                )
+    return config
+
+
+def validate_double_buffer(config):
+    """Double buffering only makes sense when frames stream out asynchronously."""
+    if config[CONF_DOUBLE_BUFFER] and not config[CONF_ASYNC_FLUSH]:
+        raise cv.Invalid("'double_buffer' requires 'async_flush: true'")
+    return config
+
+
+def validate_render_task(config):
+    """The task renders into the back buffer while loop() streams the front buffer."""
+    if not config[CONF_RENDER_TASK]:
+        return config
+    if not config[CONF_DOUBLE_BUFFER]:
+        raise cv.Invalid(f"'{CONF_RENDER_TASK}' requires 'double_buffer: true'")
+    for key in (CONF_FRAME_MODULATION, CONF_PACED_UPDATES, CONF_BENCHMARK):
+        if config[key]:
+            raise cv.Invalid(f"'{key}' cannot be combined with '{CONF_RENDER_TASK}'")
+    if CONF_TE_PIN in config:
+        raise cv.Invalid(f"'{CONF_TE_PIN}' cannot be combined with '{CONF_RENDER_TASK}'")
+    return config
+
+
+def validate_frame_modulation(config):
+    """Frame modulation streams full bitplanes from loop() and owns the grayscale path."""
+    if not config[CONF_FRAME_MODULATION]:
+        return config
+    if not config[CONF_ASYNC_FLUSH]:
+        raise cv.Invalid("'frame_modulation' requires 'async_flush: true'")
+    for key in (CONF_DIFF_UPDATES, CONF_DOUBLE_BUFFER):
+        if config[key]:
+            raise cv.Invalid(f"'{key}' cannot be combined with 'frame_modulation'")
+    if config[CONF_DITHER] != "NONE":
+        raise cv.Invalid("'dither' cannot be combined with 'frame_modulation'")
+    return config
+
+
+def validate_paced_updates(config):
+    """Paced updates render on TE edges, so they need the TE line.
+
+    A blocking transfer on every edge would hold the loop for most of each
+    refresh, so the frames have to stream out from loop().
+    """
+    if config[CONF_PACED_UPDATES]:
+        if CONF_TE_PIN not in config:
+            raise cv.Invalid("'paced_updates' requires 'te_pin'")
+        if not config[CONF_ASYNC_FLUSH]:
+            raise cv.Invalid("'paced_updates' requires 'async_flush: true'")
+        if config[CONF_FRAME_MODULATION]:
+            raise cv.Invalid("'paced_updates' cannot be combined with 'frame_modulation'")
+    return config
+
+
+def validate_power_governor(config):
+    """Sleep comes after low power, and frame modulation needs high power refresh."""
+    if governor := config.get(CONF_POWER_GOVERNOR):
+        if config[CONF_FRAME_MODULATION]:
+            raise cv.Invalid("'power_governor' cannot be combined with 'frame_modulation'")
+        sleep_after = governor.get(CONF_SLEEP_AFTER)
+        if sleep_after is not None and sleep_after <= governor[CONF_LOW_POWER_AFTER]:
+            raise cv.Invalid("'sleep_after' must be longer than 'low_power_after'")
+    return config
+
+
+def validate_strip_rows(config):
+    """Strip mode renders and sends strip by strip, so nothing may keep a full frame around."""
+    if CONF_STRIP_ROWS not in config:
+        return config
+    for key in (
+        CONF_ASYNC_FLUSH,
+        CONF_DOUBLE_BUFFER,
+        CONF_DIFF_UPDATES,
+        CONF_FRAME_MODULATION,
+        CONF_PACED_UPDATES,
+        CONF_BENCHMARK,
+        CONF_SNAPSHOT,
+    ):
+        if config[key]:
+            raise cv.Invalid(f"'{key}' cannot be combined with '{CONF_STRIP_ROWS}'")
+    if CONF_TE_PIN in config:
+        raise cv.Invalid(f"'{CONF_TE_PIN}' cannot be combined with '{CONF_STRIP_ROWS}'")
+    return config
+
+
+def validate_background(config):
+    """The retained background replaces auto clear, clearing would wipe it every frame."""
+    if CONF_BACKGROUND_LAMBDA not in config:
+        return config
+    if config.get(CONF_AUTO_CLEAR_ENABLED) is True:
+        raise cv.Invalid(
+            f"'{CONF_BACKGROUND_LAMBDA}' needs '{CONF_AUTO_CLEAR_ENABLED}: false'"
+        )
+    if CONF_STRIP_ROWS in config:
+        raise cv.Invalid(
+            f"'{CONF_BACKGROUND_LAMBDA}' cannot be combined with '{CONF_STRIP_ROWS}'"
+        )
     return config
 
 
@@ -62,6 +266,7 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(): cv.declare_id(ST7305RLCD),
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_TE_PIN): pins.internal_gpio_input_pin_schema,
             cv.Optional(CONF_MODEL, default="WAVESHARE_400X300"): cv.enum(
                 MODELS, upper=True, space="_"
             ),
@@ -69,14 +274,85 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_WIDTH): cv.int_range(min=1, max=800),
             cv.Optional(CONF_HEIGHT): cv.int_range(min=1, max=800),
             cv.Optional(CONF_ORIENTATION): cv.enum(ORIENTATIONS, upper=True),
+            cv.Optional(CONF_COL_START): cv.hex_uint8_t,
+            cv.Optional(CONF_COL_END): cv.hex_uint8_t,
+            cv.Optional(CONF_ROW_START): cv.hex_uint8_t,
+            cv.Optional(CONF_ROW_END): cv.hex_uint8_t,
+            cv.Optional(CONF_GATE_LINES): cv.hex_uint8_t,
+            cv.Optional(CONF_VOLTAGES): cv.Schema(
+                {
+                    cv.Optional(CONF_VSHP, default=0x69): cv.hex_uint8_t,
+                    cv.Optional(CONF_VSLP, default=0x19): cv.hex_uint8_t,
+                    cv.Optional(CONF_VSHN, default=0x4B): cv.hex_uint8_t,
+                    cv.Optional(CONF_VSLN, default=0x19): cv.hex_uint8_t,
+                }
+            ),
+            cv.Optional(CONF_DITHER, default="NONE"): cv.enum(DITHER_MODES, upper=True),
+            cv.Optional(CONF_VERIFY_DATA_RATE, default=False): cv.boolean,
+            cv.Optional(CONF_DIFF_UPDATES, default=False): cv.boolean,
+            cv.Optional(CONF_ASYNC_FLUSH, default=False): cv.boolean,
+            cv.Optional(CONF_FLUSH_CHUNK_ROWS, default=20): cv.int_range(min=1, max=400),
+            cv.Optional(CONF_DOUBLE_BUFFER, default=False): cv.boolean,
+            cv.Optional(CONF_FRAME_MODULATION, default=False): cv.boolean,
+            cv.Optional(
+                CONF_SUBFRAME_INTERVAL, default="20ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PACED_UPDATES, default=False): cv.boolean,
+            cv.Optional(CONF_BENCHMARK, default=False): cv.boolean,
+            cv.Optional(CONF_BUFFER_MEMORY, default="AUTO"): cv.enum(
+                BUFFER_MEMORIES, upper=True
+            ),
+            cv.Optional(CONF_IRAM_HOT_PATH, default=False): cv.boolean,
+            cv.Optional(CONF_STRIP_ROWS): cv.int_range(min=1, max=400),
+            cv.Optional(CONF_SNAPSHOT, default=False): cv.boolean,
+            cv.Optional(CONF_RESUME, default=False): cv.boolean,
+            cv.Optional(CONF_BACKGROUND_LAMBDA): cv.lambda_,
+            cv.Optional(CONF_CONTENT_HASH): cv.returning_lambda,
+            cv.Optional(CONF_WATCH): cv.ensure_list(cv.use_id(cg.EntityBase)),
+            cv.Optional(CONF_RENDER_TASK, default=False): cv.All(
+                cv.boolean, cv.only_on_esp32
+            ),
+            cv.Optional(CONF_POWER_GOVERNOR): cv.Schema(
+                {
+                    cv.Optional(
+                        CONF_LOW_POWER_AFTER, default="30s"
+                    ): cv.positive_time_period_milliseconds,
+                    cv.Optional(CONF_SLEEP_AFTER): cv.positive_time_period_milliseconds,
+                }
+            ),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
-    .extend(spi.spi_device_schema(cs_pin_required=True)),
+    .extend(spi.spi_device_schema(cs_pin_required=True, default_data_rate="10MHz")),
     validate_custom_panel,
+    validate_double_buffer,
+    validate_render_task,
+    validate_frame_modulation,
+    validate_paced_updates,
+    validate_power_governor,
+    validate_strip_rows,
+    validate_background,
 )
 
 
+def final_validate_watch(config):
+    """watch() subscribes to state callbacks, which only some entity types have."""
+    full_config = fv.full_config.get()
+    for index, entity_id in enumerate(config.get(CONF_WATCH, [])):
+        path = full_config.get_path_for_id(entity_id)[:-1]
+        declared = full_config.get_config_for_path(path)[CONF_ID]
+        if not any(declared.type.inherits_from(t) for t in WATCH_TYPES):
+            raise cv.Invalid(
+                f"'{entity_id}' is not a sensor, binary_sensor, text_sensor, switch, "
+                "number or select",
+                path=[CONF_WATCH, index],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = final_validate_watch
+
+
 async def to_code(config):
     """Generate C++ code from configuration."""
     var = cg.new_Pvariable(config[CONF_ID])
@@ -91,15 +367,90 @@ async def to_code(config):
         reset_pin = await cg.gpio_pin_expression(reset_config)
         cg.add(var.set_reset_pin(reset_pin))
 
-    cg.add(var.set_model(config[CONF_MODEL]))
+    if te_config := config.get(CONF_TE_PIN):
+        te_pin = await cg.gpio_pin_expression(te_config)
+        cg.add(var.set_te_pin(te_pin))
 
     if config[CONF_MODEL] == "CUSTOM":
+        cg.add(var.set_model(MODELS["CUSTOM"]))
         cg.add(var.set_width(config[CONF_WIDTH]))
         cg.add(var.set_height(config[CONF_HEIGHT]))
         cg.add(var.set_orientation(config[CONF_ORIENTATION]))
+        if CONF_COL_START in config:
+            cg.add(var.set_col_start(config[CONF_COL_START]))
+        if CONF_COL_END in config:
+            cg.add(var.set_col_end(config[CONF_COL_END]))
+        if CONF_ROW_START in config:
+            cg.add(var.set_row_start(config[CONF_ROW_START]))
+        if CONF_ROW_END in config:
+            cg.add(var.set_row_end(config[CONF_ROW_END]))
+        if CONF_GATE_LINES in config:
+            cg.add(var.set_gate_lines(config[CONF_GATE_LINES]))
+        if voltages := config.get(CONF_VOLTAGES):
+            cg.add(
+                var.set_voltages(
+                    voltages[CONF_VSHP],
+                    voltages[CONF_VSLP],
+                    voltages[CONF_VSHN],
+                    voltages[CONF_VSLN],
+                )
+            )
+    else:
+        cg.add(var.set_profile(PROFILES[config[CONF_MODEL]]))
+
+    cg.add(var.set_dither(config[CONF_DITHER]))
+    cg.add(var.set_verify_data_rate(config[CONF_VERIFY_DATA_RATE]))
+    cg.add(var.set_diff_updates(config[CONF_DIFF_UPDATES]))
+    cg.add(var.set_async_flush(config[CONF_ASYNC_FLUSH]))
+    cg.add(var.set_flush_chunk_rows(config[CONF_FLUSH_CHUNK_ROWS]))
+    cg.add(var.set_double_buffer(config[CONF_DOUBLE_BUFFER]))
+    cg.add(var.set_frame_modulation(config[CONF_FRAME_MODULATION]))
+    cg.add(var.set_subframe_interval(config[CONF_SUBFRAME_INTERVAL]))
+    cg.add(var.set_paced_updates(config[CONF_PACED_UPDATES]))
+    cg.add(var.set_benchmark_on_boot(config[CONF_BENCHMARK]))
+    cg.add(var.set_buffer_memory(config[CONF_BUFFER_MEMORY]))
+    if CONF_STRIP_ROWS in config:
+        cg.add(var.set_strip_rows(config[CONF_STRIP_ROWS]))
+    cg.add(var.set_snapshot(config[CONF_SNAPSHOT]))
+    cg.add(var.set_resume(config[CONF_RESUME]))
+    cg.add(var.set_render_task(config[CONF_RENDER_TASK]))
+    if config[CONF_IRAM_HOT_PATH]:
+        cg.add_define("ST7305_IRAM_HOT_PATH")
+    if governor := config.get(CONF_POWER_GOVERNOR):
+        cg.add(
+            var.set_power_governor(
+                governor[CONF_LOW_POWER_AFTER], governor.get(CONF_SLEEP_AFTER, 0)
+            )
+        )
 
     if lambda_config := config.get(CONF_LAMBDA):
         lambda_ = await cg.process_lambda(
             lambda_config, [(display.DisplayRef, "it")], return_type=cg.void
         )
         cg.add(var.set_writer(lambda_))
+
+    if background_config := config.get(CONF_BACKGROUND_LAMBDA):
+        background_ = await cg.process_lambda(
+            background_config, [(display.DisplayRef, "it")], return_type=cg.void
+        )
+        cg.add(var.set_background_writer(background_))
+        cg.add(var.set_auto_clear(False))
+
+    if hash_config := config.get(CONF_CONTENT_HASH):
+        hash_ = await cg.process_lambda(hash_config, [], return_type=cg.uint32)
+        cg.add(var.set_content_hash(hash_))
+    for entity_id in config.get(CONF_WATCH, []):
+        entity = await cg.get_variable(entity_id)
+        cg.add(var.watch(entity))
+
+
+@automation.register_action(
+    "st7305_rlcd.benchmark",
+    BenchmarkAction,
+    automation.maybe_simple_id({cv.GenerateID(): cv.use_id(ST7305RLCD)}),
+)
+async def benchmark_action_to_code(config, action_id, template_arg, args):
+    """Run the on-device benchmark suite."""
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -0,0 +1,75 @@
+"""Instrumentation sensors for the ST7305 RLCD display."""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_UPDATE_INTERVAL,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_BYTES,
+    UNIT_MILLISECOND,
+)
+
+from .display import ST7305RLCD
+
+DEPENDENCIES = ["st7305_rlcd"]
+
+CONF_ST7305_RLCD_ID = "st7305_rlcd_id"
+CONF_RENDER_TIME = "render_time"
+CONF_WRITE_TIME = "write_time"
+CONF_BYTES_SENT = "bytes_sent"
+CONF_FRAMES_SKIPPED = "frames_skipped"
+CONF_PIXEL_CALLS = "pixel_calls"
+
+TIME_SENSOR_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    accuracy_decimals=2,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    icon="mdi:timer-outline",
+)
+
+COUNT_SENSOR_SCHEMA = sensor.sensor_schema(
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_TOTAL_INCREASING,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    icon="mdi:counter",
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_ST7305_RLCD_ID): cv.use_id(ST7305RLCD),
+        cv.Optional(CONF_RENDER_TIME): TIME_SENSOR_SCHEMA,
+        cv.Optional(CONF_WRITE_TIME): TIME_SENSOR_SCHEMA,
+        cv.Optional(CONF_BYTES_SENT): sensor.sensor_schema(
+            unit_of_measurement=UNIT_BYTES,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            icon="mdi:transfer",
+        ),
+        cv.Optional(CONF_FRAMES_SKIPPED): COUNT_SENSOR_SCHEMA,
+        cv.Optional(CONF_PIXEL_CALLS): COUNT_SENSOR_SCHEMA,
+        cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+    }
+)
+
+SENSORS = {
+    CONF_RENDER_TIME: "set_render_time_sensor",
+    CONF_WRITE_TIME: "set_write_time_sensor",
+    CONF_BYTES_SENT: "set_bytes_sent_sensor",
+    CONF_FRAMES_SKIPPED: "set_frames_skipped_sensor",
+    CONF_PIXEL_CALLS: "set_pixel_calls_sensor",
+}
+
+
+async def to_code(config):
+    """Attach the sensors to the display and set how often they publish."""
+    parent = await cg.get_variable(config[CONF_ST7305_RLCD_ID])
+    for key, setter in SENSORS.items():
+        if sensor_config := config.get(key):
+            sens = await sensor.new_sensor(sensor_config)
+            cg.add(getattr(parent, setter)(sens))
+    cg.add(parent.set_stats_interval(config[CONF_UPDATE_INTERVAL]))
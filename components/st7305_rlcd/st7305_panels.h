@@ -0,0 +1,76 @@
+/**
+ * @file st7305_panels.h
+ * @brief Compile-time panel profiles for ST7305 reflective LCD displays
+ *
+ * Each predefined model is a constexpr profile holding geometry, address
+ * window, gate line setting, source voltages and the timing init sequence.
+ * The Python codegen passes only the selected profile to the driver, so
+ * unused profiles emit no data.
+ *
+ * @version 2.0.0
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace st7305_rlcd {
+
+/// Panel model enumeration
+enum ST7305Model : uint8_t {
+  ST7305_MODEL_WAVESHARE_400X300 = 0,  ///< Landscape 2×4 blocks
+  ST7305_MODEL_OSPTEK_200X200,         ///< Square 4×2 blocks
+  ST7305_MODEL_CUSTOM,                 ///< User-defined
+};
+
+/// Pixel block orientation (determines buffer addressing)
+enum ST7305Orientation : uint8_t {
+  ST7305_ORIENTATION_LANDSCAPE = 0,  ///< 2 cols × 4 rows per byte
+  ST7305_ORIENTATION_PORTRAIT,       ///< 4 cols × 2 rows per byte
+};
+
+/// Oscillator, frame rate and gate/source EQ timing shared by all known panels
+/// ({command, parameter count, parameters...}, terminated by 0x00)
+extern const uint8_t ST7305_INIT_TIMING_DEFAULT[];
+
+/// Static description of one panel type
+struct ST7305PanelProfile {
+  const char *name;
+  ST7305Model model;
+  uint16_t width;
+  uint16_t height;
+  ST7305Orientation orientation;
+  // Address window (0x2A columns, 0x2B rows)
+  uint8_t col_start;
+  uint8_t col_end;
+  uint8_t row_start;
+  uint8_t row_end;
+  uint8_t gate_lines;  ///< 0xB0 parameter
+  // Source voltages (0xC1 VSHP, 0xC2 VSLP, 0xC4 VSHN, 0xC5 VSLN)
+  uint8_t vshp;
+  uint8_t vslp;
+  uint8_t vshn;
+  uint8_t vsln;
+  const uint8_t *timing_sequence;
+};
+
+/// Waveshare ESP32-S3-RLCD-4.2 / GooDisplay GDTL042T71
+constexpr ST7305PanelProfile ST7305_PROFILE_WAVESHARE_400X300 = {
+    "Waveshare 400x300", ST7305_MODEL_WAVESHARE_400X300, 400, 300, ST7305_ORIENTATION_LANDSCAPE,
+    0x12, 0x2A, 0x00, 0xC7,
+    0x64,  // 100 * 3 = 300 lines
+    0x69, 0x19, 0x4B, 0x19, ST7305_INIT_TIMING_DEFAULT,
+};
+
+/// Osptek YDP154H008
+constexpr ST7305PanelProfile ST7305_PROFILE_OSPTEK_200X200 = {
+    "Osptek 200x200", ST7305_MODEL_OSPTEK_200X200, 200, 200, ST7305_ORIENTATION_PORTRAIT,
+    // Address window for 200×200 - estimated based on panel size
+    0x13, 0x25, 0x00, 0x63,
+    0x32,  // 50 * 4 = 200 lines
+    0x69, 0x19, 0x4B, 0x19, ST7305_INIT_TIMING_DEFAULT,
+};
+
+}  // namespace st7305_rlcd
+}  // namespace esphome
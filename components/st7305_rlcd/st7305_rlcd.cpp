@@ -11,14 +11,99 @@
  */
 
 #include "st7305_rlcd.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#include <esp_system.h>
+#endif
+
 namespace esphome {
 namespace st7305_rlcd {
 
 static const char *const TAG = "st7305_rlcd";
 
+// RTC slow memory survives deep sleep on ESP32; elsewhere the snapshot only lasts until reset
+#ifdef USE_ESP32
+#define ST7305_RTC_ATTR RTC_NOINIT_ATTR
+#else
+#define ST7305_RTC_ATTR
+#endif
+
+static const uint32_t ST7305_SNAPSHOT_MAGIC = 0x53543735;  // "ST75"
+
+/// RLE-packed framebuffer; one per firmware, so only one panel can use it
+struct ST7305Snapshot {
+  uint32_t magic;
+  uint32_t geometry;  ///< Panel the frame belongs to, see snapshot_geometry_()
+  uint16_t length;    ///< Packed bytes in data
+  uint16_t crc;       ///< CRC16 of data
+  uint32_t content_hash;  ///< content_hash value the frame was rendered from
+  uint8_t data[ST7305_SNAPSHOT_CAPACITY];
+};
+static ST7305_RTC_ATTR ST7305Snapshot st7305_snapshot;
+
+static const uint32_t ST7305_PANEL_STATE_MAGIC = 0x53545032;  // "STP2"
+
+/// Panel state at shutdown, lets the next boot take over a still powered panel
+struct ST7305PanelState {
+  uint32_t magic;
+  uint32_t geometry;
+  bool sleeping;
+  bool low_power;
+  bool display_off;
+  bool in_sync;  ///< Panel RAM matched the framebuffer when it was saved
+};
+static ST7305_RTC_ATTR ST7305PanelState st7305_panel_state;
+
+// Init sequences as {command, parameter count, parameters...}, terminated by 0x00.
+// Each command goes out in a single CS assertion.
+
+// Power setup, sent before the panel source voltages
+static const uint8_t ST7305_INIT_POWER[] = {
+    0xD6, 2, 0x17, 0x02,  // NVM Load Control
+    0xD1, 1, 0x01,        // Booster Enable
+    0xC0, 2, 0x11, 0x04,  // Gate Voltage Setting (VGH/VGL)
+    0x00,
+};
+
+// Timing setup shared by the predefined panel profiles, sent after the source voltages
+const uint8_t ST7305_INIT_TIMING_DEFAULT[] = {
+    0xD8, 2, 0x80, 0xE9,                                            // OSC Setting
+    0xB2, 1, 0x02,                                                  // Frame Rate Control
+    0xB3, 10, 0xE5, 0xF6, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45,  // Gate EQ Control (high power)
+    0xB4, 8, 0x05, 0x46, 0x77, 0x77, 0x77, 0x77, 0x76, 0x45,        // Gate EQ Control (low power)
+    0x62, 3, 0x32, 0x03, 0x1F,                                      // Gate Timing Control
+    0xB7, 1, 0x13,                                                  // Source EQ Enable
+    0x00,
+};
+
+// Display format setup, sent after sleep out
+static const uint8_t ST7305_INIT_DISPLAY[] = {
+    0xC9, 1, 0x00,  // Source Voltage Select - VSHP1/VSLP1/VSHN1/VSLN1
+    0x36, 1, 0x48,  // Memory Data Access Control - MX=1, DO=1
+    0x3A, 1, 0x11,  // Data Format Select - 1-bit monochrome
+    0xB9, 1, 0x20,  // Gamma Mode Setting - Monochrome
+    0xB8, 1, 0x29,  // Panel Setting - 1-dot inversion, frame inversion, interlace
+    0x21, 0,        // Display Inversion On
+    0x00,
+};
+
+// Sent after the address window
+static const uint8_t ST7305_INIT_ENABLE[] = {
+    0x35, 1, 0x00,  // Tearing Effect Line On
+    0xD0, 1, 0xFF,  // Auto Power Down Control
+    0x38, 0,        // High Power Mode On
+    0x29, 0,        // Display On
+    0x00,
+};
+
 // =============================================================================
 // Setup and Configuration
 // =============================================================================
@@ -37,64 +122,206 @@ void ST7305RLCD::setup() {
     this->reset_pin_->setup();
   }
 
+  // TE pulses once per panel refresh (0x35 mode 0: V-blank only)
+  if (this->te_pin_ != nullptr) {
+    this->te_pin_->setup();
+    this->te_pin_->attach_interrupt(&ST7305RLCD::te_isr_, this, gpio::INTERRUPT_RISING_EDGE);
+    if (this->paced_updates_)
+      this->high_freq_.start();
+  }
+
   // Initialize SPI
   this->spi_setup();
 
+  if (this->async_flush_ && !this->partial_window_) {
+    ESP_LOGW(TAG, "Async flush needs a partial address window, using blocking writes");
+    this->async_flush_ = false;
+  }
+
   // Allocate display buffer
-  ExternalRAMAllocator<uint8_t> buffer_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  this->buffer_ = buffer_allocator.allocate(this->buffer_size_);
+  this->buffer_ = this->allocate_buffer_(this->buffer_size_, true);
   if (this->buffer_ == nullptr) {
     ESP_LOGE(TAG, "Failed to allocate display buffer (%zu bytes)", this->buffer_size_);
     this->mark_failed();
     return;
   }
-  memset(this->buffer_, 0xFF, this->buffer_size_);
+  this->select_pixel_fn_();
+  // Last frame from before deep sleep, sent as soon as the panel is ready.
+  // The decode fills every byte, so the buffer is only cleared without one.
+  if (this->snapshot_ && this->restore_snapshot()) {
+    this->snapshot_restored_ = true;
+    this->write_when_ready_ = true;
+  } else {
+    memset(this->buffer_, 0xFF, this->buffer_size_);
+  }
+  // Panel RAM content is unknown after reset, the first write covers everything
+  this->mark_dirty_all_();
+
+  // Allocate front buffer for double buffering. It is left uninitialized: every flush
+  // copies its dirty window in first and never reads outside it.
+  if (this->double_buffer_ && this->async_flush_) {
+    this->front_buffer_ = this->allocate_buffer_(this->buffer_size_);
+    if (this->front_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Failed to allocate front buffer (%zu bytes), double buffering disabled", this->buffer_size_);
+    }
+  }
+  this->flush_buffer_ = this->buffer_;
+
+  // Allocate the LSB bitplane for frame modulation grayscale
+  if (this->frame_modulation_) {
+    if (!this->async_flush_) {
+      ESP_LOGW(TAG, "Frame modulation needs async flush, disabled");
+    } else {
+      this->gray_plane_ = this->allocate_buffer_(this->buffer_size_);
+      if (this->gray_plane_ == nullptr) {
+        ESP_LOGW(TAG, "Failed to allocate gray bitplane (%zu bytes), frame modulation disabled", this->buffer_size_);
+      } else {
+        memset(this->gray_plane_, 0xFF, this->buffer_size_);
+        // Every subframe is a full-window write, there is nothing to diff against
+        this->diff_updates_ = false;
+      }
+    }
+  }
 
-  // Initialize pixel lookup tables
-  this->init_pixel_lut_();
-  if (this->pixel_index_lut_ == nullptr || this->pixel_bit_lut_ == nullptr) {
-    ESP_LOGE(TAG, "Failed to allocate pixel LUTs");
-    this->mark_failed();
-    return;
+  // The restored frame stands for the lambda until content_hash differs from the saved value.
+  // Frame modulation needs the gray plane too, which isn't kept.
+  if (this->snapshot_restored_ && this->content_hash_ && this->gray_plane_ == nullptr) {
+    this->last_content_hash_ = st7305_snapshot.content_hash;
+    this->content_dirty_ = false;
+    this->content_rotation_ = this->rotation_;
   }
 
-  // Hardware initialization
-  this->hardware_reset_();
-  this->init_display_();
+  // Retained background plane, drawn by its own lambda on the first update
+  if (this->background_writer_) {
+    this->background_ = this->create_layer();
+    if (this->background_ == nullptr)
+      ESP_LOGW(TAG, "No background plane, the background lambda is not drawn");
+  }
+
+  // Allocate shadow buffer; it becomes valid after the first full write
+  if (this->diff_updates_) {
+    this->shadow_buffer_ = this->allocate_buffer_(this->buffer_size_);
+    if (this->shadow_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Failed to allocate shadow buffer (%zu bytes), diff updates disabled", this->buffer_size_);
+      this->diff_updates_ = false;
+    }
+  }
+
+#ifdef USE_SENSOR
+  if (this->stats_interval_ != 0)
+    this->set_interval("stats", this->stats_interval_, [this]() { this->publish_stats_(); });
+#endif
+
+  // Render task on the core the loop doesn't use; the back buffer is its only shared state
+  if (this->render_task_enabled_) {
+#ifdef USE_ESP32
+    if (this->front_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Render task needs double buffering, rendering on the loop");
+    } else {
+#if portNUM_PROCESSORS > 1
+      const BaseType_t core = 1 - xPortGetCoreID();
+#else
+      const BaseType_t core = tskNO_AFFINITY;
+#endif
+      if (xTaskCreatePinnedToCore(render_task_fn_, "st7305_render", ST7305_RENDER_TASK_STACK, this, 1,
+                                  &this->render_task_, core) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start render task, rendering on the loop");
+        this->render_task_ = nullptr;
+      }
+    }
+#else
+    ESP_LOGW(TAG, "Render task needs an ESP32, rendering on the loop");
+#endif
+  }
+
+  // Join the shared flush scheduler once nothing can fail any more
+  if (this->async_flush_)
+    flush_peers_.push_back(this);
+
+  // Hardware initialization runs from the scheduler; draws before it finishes stay in the buffer
+  this->ready_ = false;
+  if (!this->resume_ || !this->resume_panel_())
+    this->hardware_reset_();
 
   ESP_LOGCONFIG(TAG, "ST7305 RLCD setup complete");
 }
 
-void ST7305RLCD::apply_model_settings_() {
-  switch (this->model_) {
-    case ST7305_MODEL_WAVESHARE_400X300:
-      this->width_ = 400;
-      this->height_ = 300;
-      this->orientation_ = ST7305_ORIENTATION_LANDSCAPE;
-      this->buffer_size_ = (400 * 300) / 8;  // 15000 bytes
-      this->col_start_ = 0x12;
-      this->col_end_ = 0x2A;
-      this->row_start_ = 0x00;
-      this->row_end_ = 0xC7;
-      break;
+uint8_t *ST7305RLCD::allocate_buffer_(size_t size, bool primary) {
+  // AUTO keeps only the framebuffer the pixel writes go to internal; the bulk-copied buffers prefer PSRAM
+  const bool internal_first =
+      this->buffer_memory_ == ST7305_BUFFER_MEMORY_INTERNAL ||
+      (this->buffer_memory_ == ST7305_BUFFER_MEMORY_AUTO && primary && size <= ST7305_AUTO_INTERNAL_MAX);
+  if (internal_first) {
+    RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL | RAMAllocator<uint8_t>::ALLOW_FAILURE);
+    uint8_t *buffer = allocator.allocate(size);
+    if (buffer != nullptr) {
+      if (primary)
+        this->buffer_external_ = false;
+      return buffer;
+    }
+    if (this->buffer_memory_ == ST7305_BUFFER_MEMORY_INTERNAL)
+      ESP_LOGW(TAG, "No internal RAM for %zu bytes, falling back to PSRAM", size);
+  }
 
-    case ST7305_MODEL_OSPTEK_200X200:
-      this->width_ = 200;
-      this->height_ = 200;
-      this->orientation_ = ST7305_ORIENTATION_PORTRAIT;
-      this->buffer_size_ = (200 * 200) / 8;  // 5000 bytes
-      // Address window for 200×200 - estimated based on panel size
-      this->col_start_ = 0x13;
-      this->col_end_ = 0x25;
-      this->row_start_ = 0x00;
-      this->row_end_ = 0x63;
-      break;
+  // Prefers PSRAM, falls back to internal RAM when there is none
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  if (primary)
+    this->buffer_external_ = true;
+  return allocator.allocate(size);
+}
 
-    case ST7305_MODEL_CUSTOM:
-      // User has set width_, height_, orientation_ directly
-      this->buffer_size_ = (this->width_ * this->height_) / 8;
-      // User should also set address window via separate methods if needed
-      break;
+void ST7305RLCD::set_profile(const ST7305PanelProfile &profile) {
+  this->model_name_ = profile.name;
+  this->model_ = profile.model;
+  this->width_ = profile.width;
+  this->height_ = profile.height;
+  this->orientation_ = profile.orientation;
+  this->col_start_ = profile.col_start;
+  this->col_end_ = profile.col_end;
+  this->row_start_ = profile.row_start;
+  this->row_end_ = profile.row_end;
+  this->gate_lines_ = profile.gate_lines;
+  this->vshp_ = profile.vshp;
+  this->vslp_ = profile.vslp;
+  this->vshn_ = profile.vshn;
+  this->vsln_ = profile.vsln;
+  this->timing_sequence_ = profile.timing_sequence;
+}
+
+void ST7305RLCD::apply_model_settings_() {
+  // Geometry and window come from the profile (or CUSTOM setters); only derived values are computed here
+  if (this->gate_lines_ == 0)
+    this->gate_lines_ = static_cast<uint8_t>(this->height_ / 3);
+
+  // Each panel RAM row holds two pixels along one axis; each byte packs four
+  // pixels along the other. Partial blocks at the edges are rounded up.
+  if (this->orientation_ == ST7305_ORIENTATION_LANDSCAPE) {
+    this->block_stride_ = (this->height_ + 3) >> 2;
+    this->buffer_size_ = static_cast<size_t>((this->width_ + 1) >> 1) * this->block_stride_;  // 15000 bytes for 400x300
+  } else {
+    this->block_stride_ = (this->width_ + 3) >> 2;
+    this->buffer_size_ = static_cast<size_t>((this->height_ + 1) >> 1) * this->block_stride_;  // 5000 bytes for 200x200
+  }
+  this->panel_rows_ = this->buffer_size_ / this->block_stride_;
+  this->buffer_rows_ = this->panel_rows_;
+
+  // Partial writes need the 0x2A/0x2B window to map 1:1 onto buffer rows and columns.
+  // Otherwise every write falls back to the full window.
+  const uint16_t window_cols = this->col_end_ - this->col_start_ + 1;
+  const uint16_t window_rows = this->row_end_ - this->row_start_ + 1;
+  this->partial_window_ = this->block_stride_ == window_cols * ST7305_BYTES_PER_COLUMN &&
+                          this->panel_rows_ == window_rows;
+
+  // Strip mode narrows the 0x2B window per strip, which needs the same 1:1 mapping
+  if (this->strip_rows_ != 0 && !this->partial_window_) {
+    ESP_LOGW(TAG, "Strip mode needs a partial address window, using a full framebuffer");
+    this->strip_rows_ = 0;
+  }
+  if (this->strip_rows_ != 0 && this->strip_rows_ < this->panel_rows_) {
+    this->buffer_rows_ = this->strip_rows_;
+    this->buffer_size_ = static_cast<size_t>(this->buffer_rows_) * this->block_stride_;
+  } else {
+    this->strip_rows_ = 0;
   }
 
   ESP_LOGD(TAG, "Model settings: %dx%d, %s, buffer=%zu bytes",
@@ -106,323 +333,1215 @@ void ST7305RLCD::apply_model_settings_() {
 void ST7305RLCD::dump_config() {
   LOG_DISPLAY("", "ST7305 RLCD", this);
 
-  const char *model_name;
-  switch (this->model_) {
-    case ST7305_MODEL_WAVESHARE_400X300:
-      model_name = "Waveshare 400x300";
-      break;
-    case ST7305_MODEL_OSPTEK_200X200:
-      model_name = "Osptek 200x200";
-      break;
-    case ST7305_MODEL_CUSTOM:
-      model_name = "Custom";
-      break;
-    default:
-      model_name = "Unknown";
-  }
-
-  ESP_LOGCONFIG(TAG, "  Model: %s", model_name);
+  ESP_LOGCONFIG(TAG, "  Model: %s", this->model_name_);
   ESP_LOGCONFIG(TAG, "  Resolution: %dx%d", this->width_, this->height_);
   ESP_LOGCONFIG(TAG, "  Orientation: %s",
                 this->orientation_ == ST7305_ORIENTATION_LANDSCAPE ? "Landscape (2x4)" : "Portrait (4x2)");
-  ESP_LOGCONFIG(TAG, "  Buffer Size: %zu bytes", this->buffer_size_);
+  static const char *const BUFFER_MEMORY_NAMES[] = {"auto", "internal", "external"};
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %zu bytes (%s, %s preferred)", this->buffer_size_,
+                this->buffer_external_ ? "PSRAM if present" : "internal RAM", BUFFER_MEMORY_NAMES[this->buffer_memory_]);
+  if (this->background_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Background Plane: %zu bytes", this->buffer_size_);
+  }
+  if (this->strip_rows_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Strip Mode: %u of %u rows per pass", this->buffer_rows_, this->panel_rows_);
+  }
+  ESP_LOGCONFIG(TAG, "  Address Window: cols 0x%02X-0x%02X, rows 0x%02X-0x%02X", this->col_start_, this->col_end_,
+                this->row_start_, this->row_end_);
+  ESP_LOGCONFIG(TAG, "  Gate Lines: 0x%02X", this->gate_lines_);
+  ESP_LOGCONFIG(TAG, "  Partial Updates: %s", this->partial_window_ ? "YES" : "NO (window does not match buffer)");
   ESP_LOGCONFIG(TAG, "  Rotated Size: %dx%d", this->get_width(), this->get_height());
+  ESP_LOGCONFIG(TAG, "  Dithering: %s", this->dither_ == ST7305_DITHER_NONE ? "none" : "Bayer 4x4");
+  ESP_LOGCONFIG(TAG, "  Data Rate: %" PRIu32 " Hz%s", this->data_rate_,
+                this->verify_data_rate_ ? " (verified at setup)" : "");
+  ESP_LOGCONFIG(TAG, "  Diff Updates: %s", YESNO(this->diff_updates_));
+  ESP_LOGCONFIG(TAG, "  Async Flush: %s", YESNO(this->async_flush_));
+  if (this->async_flush_) {
+    ESP_LOGCONFIG(TAG, "  Flush Chunk: %u rows", this->flush_chunk_rows_);
+    ESP_LOGCONFIG(TAG, "  Shared Scheduler: %s (%u panels)", YESNO(flush_peers_.size() > 1),
+                  static_cast<unsigned>(flush_peers_.size()));
+    ESP_LOGCONFIG(TAG, "  Double Buffer: %s", YESNO(this->front_buffer_ != nullptr));
+#ifdef USE_ESP32
+    if (this->render_task_ != nullptr) {
+      ESP_LOGCONFIG(TAG, "  Render Task: YES");
+    }
+#endif
+    ESP_LOGCONFIG(TAG, "  Frame Modulation: %s", YESNO(this->gray_plane_ != nullptr));
+    if (this->gray_plane_ != nullptr) {
+      ESP_LOGCONFIG(TAG, "  Subframe Interval: %" PRIu32 "ms", this->subframe_interval_);
+    }
+  }
+  if (this->diff_updates_) {
+    ESP_LOGCONFIG(TAG, "  Bytes Compared: %" PRIu32, this->bytes_compared_);
+  }
+  ESP_LOGCONFIG(TAG, "  Bytes Sent: %" PRIu32, this->bytes_sent_);
+  ESP_LOGCONFIG(TAG, "  Frames Skipped: %" PRIu32, this->frames_skipped_);
+  ESP_LOGCONFIG(TAG, "  Pixel Calls: %" PRIu32, this->pixel_calls_);
+  ESP_LOGCONFIG(TAG, "  Last Render Time: %" PRIu32 "us", this->get_render_time_us());
+  ESP_LOGCONFIG(TAG, "  Last Write Time: %" PRIu32 "us", this->get_write_time_us());
   LOG_PIN("  DC Pin: ", this->dc_pin_);
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
+  ESP_LOGCONFIG(TAG, "  Power Governor: %s", YESNO(this->power_governor_));
+  if (this->power_governor_) {
+    ESP_LOGCONFIG(TAG, "  Low Power After: %" PRIu32 "ms", this->low_power_after_);
+    if (this->sleep_after_ != 0) {
+      ESP_LOGCONFIG(TAG, "  Sleep After: %" PRIu32 "ms", this->sleep_after_);
+    }
+  }
+  if (this->content_hash_ || this->watching_) {
+    ESP_LOGCONFIG(TAG, "  Render Skipping: %s%s", this->content_hash_ ? "content hash " : "",
+                  this->watching_ ? "watched entities" : "");
+  }
+  if (this->resume_) {
+    ESP_LOGCONFIG(TAG, "  Resume: %s", this->resumed_ ? "YES (reset and init skipped)" : "NO (cold init)");
+  }
+  if (this->snapshot_) {
+    const unsigned stored = st7305_snapshot.magic == ST7305_SNAPSHOT_MAGIC ? st7305_snapshot.length : 0;
+    ESP_LOGCONFIG(TAG, "  Snapshot: %u of %u bytes%s", stored, (unsigned) sizeof(st7305_snapshot.data),
+                  this->snapshot_restored_ ? " (restored)" : "");
+  }
+  if (this->te_pin_ != nullptr) {
+    LOG_PIN("  TE Pin: ", this->te_pin_);
+    ESP_LOGCONFIG(TAG, "  Paced Updates: %s", YESNO(this->paced_updates_));
+    ESP_LOGCONFIG(TAG, "  Missed VSyncs: %" PRIu32, this->missed_vsyncs_);
+  }
+}
+
+void ST7305RLCD::verify_data_rate_setup_() {
+  if (this->data_rate_ <= ST7305_SAFE_DATA_RATE)
+    return;
+
+  // Read the ID at the configured rate, then again at the safe rate as reference.
+  // Both reads share the same dummy-bit framing, so a raw compare is enough.
+  const uint32_t fast_rate = this->data_rate_;
+  uint8_t fast_id[4], safe_id[4];
+  this->read_display_id_(fast_id);
+
+  this->spi_teardown();
+  this->set_data_rate(ST7305_SAFE_DATA_RATE);
+  this->spi_setup();
+  if (!this->read_display_id_(safe_id)) {
+    ESP_LOGW(TAG, "Display ID reads as idle bus (MISO not wired?), keeping %" PRIu32 " Hz unverified", fast_rate);
+  } else if (memcmp(fast_id, safe_id, sizeof(fast_id)) != 0) {
+    ESP_LOGW(TAG,
+             "Display ID mismatch at %" PRIu32 " Hz (%02X%02X%02X%02X vs %02X%02X%02X%02X), "
+             "falling back to %" PRIu32 " Hz",
+             fast_rate, fast_id[0], fast_id[1], fast_id[2], fast_id[3], safe_id[0], safe_id[1], safe_id[2],
+             safe_id[3], ST7305_SAFE_DATA_RATE);
+    return;
+  } else {
+    ESP_LOGD(TAG, "Data rate %" PRIu32 " Hz verified", fast_rate);
+  }
+
+  this->spi_teardown();
+  this->set_data_rate(fast_rate);
+  this->spi_setup();
+}
+
+bool ST7305RLCD::read_display_id_(uint8_t *id) {
+  // Read Display ID (0x04): dummy clock followed by 3 ID bytes, read as 4 raw bytes
+  this->dc_pin_->digital_write(false);
+  this->enable();
+  this->write_byte(0x04);
+  this->dc_pin_->digital_write(true);
+  this->read_array(id, 4);
+  this->disable();
+
+  // An unconnected MISO line reads as all zeros or all ones
+  bool all_zero = true, all_one = true;
+  for (uint8_t i = 0; i < 4; i++) {
+    all_zero &= id[i] == 0x00;
+    all_one &= id[i] == 0xFF;
+  }
+  return !all_zero && !all_one;
+}
+
+#ifdef USE_SENSOR
+void ST7305RLCD::publish_stats_() {
+  if (this->render_time_sensor_ != nullptr)
+    this->render_time_sensor_->publish_state(this->get_render_time_us() / 1000.0f);
+  if (this->write_time_sensor_ != nullptr)
+    this->write_time_sensor_->publish_state(this->get_write_time_us() / 1000.0f);
+  if (this->bytes_sent_sensor_ != nullptr)
+    this->bytes_sent_sensor_->publish_state(this->bytes_sent_);
+  if (this->frames_skipped_sensor_ != nullptr)
+    this->frames_skipped_sensor_->publish_state(this->frames_skipped_);
+  if (this->pixel_calls_sensor_ != nullptr)
+    this->pixel_calls_sensor_->publish_state(this->pixel_calls_);
 }
+#endif
 
 // =============================================================================
 // Display Operations
 // =============================================================================
 
 void ST7305RLCD::update() {
+  // The restored frame went out when the panel became ready, this update renders as usual
+  this->snapshot_restored_ = false;
+#ifdef USE_ESP32
+  // The task owns the buffer and dirty window until the handback, the content check waits for it
+  if (this->render_task_ != nullptr && this->render_state_.load(std::memory_order_acquire) != ST7305_RENDER_IDLE) {
+    this->render_requested_ = true;
+    return;
+  }
+#endif
+  if (!this->content_changed_()) {
+    this->frames_skipped_++;
+    return;
+  }
+  this->update_frame_();
+}
+
+void ST7305RLCD::update_frame_() {
+#ifdef USE_ESP32
+  if (this->render_task_ != nullptr) {
+    // One frame in flight at a time; a request meanwhile starts the next one right after
+    if (this->render_state_.load(std::memory_order_acquire) != ST7305_RENDER_IDLE) {
+      this->render_requested_ = true;
+      return;
+    }
+    this->start_render_();
+    return;
+  }
+#endif
+  if (this->strip_rows_ != 0) {
+    this->update_strips_();
+    return;
+  }
+  if (this->flushing_) {
+    if (this->front_buffer_ == nullptr) {
+      // The buffer is being streamed out, drawing now would tear the frame
+      this->update_pending_ = true;
+      return;
+    }
+    // Double buffered: render into the back buffer now, send it once the front buffer is out
+    this->render_();
+    this->write_pending_ = true;
+    return;
+  }
+  this->render_();
+  // Frame modulation sends the bitplanes continuously from loop()
+  if (this->gray_plane_ == nullptr)
+    this->queue_write_();
+}
+
+bool ST7305RLCD::content_changed_() {
+  if (!this->content_hash_ && !this->watching_)
+    return true;
+  bool changed = this->content_dirty_;
+  this->content_dirty_ = false;
+  // Draws from outside the lambda or a rotation change still need a frame
+  if (this->is_dirty_() || this->rotation_ != this->content_rotation_) {
+    this->content_rotation_ = this->rotation_;
+    changed = true;
+  }
+  // Always evaluated, so the stored hash matches the frame being drawn
+  if (this->content_hash_) {
+    const uint32_t hash = this->content_hash_();
+    changed |= hash != this->last_content_hash_;
+    this->last_content_hash_ = hash;
+  }
+  return changed;
+}
+
+void ST7305RLCD::render_() {
+  // Cycle counter reads are a single register access, cheap enough to leave on
+  const uint32_t start = arch_get_cpu_cycle_count();
+  if (this->background_ != nullptr) {
+    this->render_over_background_();
+  } else {
+    this->do_update_();
+  }
+  this->render_cycles_ = arch_get_cpu_cycle_count() - start;
+}
+
+void ST7305RLCD::render_over_background_() {
+  // Draws from outside the lambda and frames not sent yet stay dirty
+  const bool pending = this->is_dirty_();
+  const uint16_t pending_rows[] = {this->dirty_row_min_, this->dirty_row_max_};
+  const uint16_t pending_cols[] = {this->dirty_col_min_, this->dirty_col_max_};
+
+  bool full = false;
+  if (!this->background_valid_) {
+    this->draw_layer(this->background_, [this]() { this->background_writer_(*this); });
+    this->background_valid_ = true;
+    full = true;
+    memcpy(this->buffer_, this->background_, this->buffer_size_);
+    if (this->gray_plane_ != nullptr)
+      memcpy(this->gray_plane_, this->background_, this->buffer_size_);
+  } else if (this->overlay_row_min_ <= this->overlay_row_max_) {
+    // Put the background back where the previous overlay drew
+    const uint16_t length = this->overlay_col_max_ + 1 - this->overlay_col_min_;
+    for (uint16_t row = this->overlay_row_min_; row <= this->overlay_row_max_; row++) {
+      const uint32_t offset = static_cast<uint32_t>(row) * this->block_stride_ + this->overlay_col_min_;
+      memcpy(this->buffer_ + offset, this->background_ + offset, length);
+      if (this->gray_plane_ != nullptr)
+        memcpy(this->gray_plane_ + offset, this->background_ + offset, length);
+    }
+  }
+  const uint16_t restored_rows[] = {this->overlay_row_min_, this->overlay_row_max_};
+  const uint16_t restored_cols[] = {this->overlay_col_min_, this->overlay_col_max_};
+
+  // Whatever the lambda changes now is the overlay, restored before the next frame
+  this->clear_dirty_();
   this->do_update_();
-  this->write_display_();
+  this->overlay_row_min_ = this->dirty_row_min_, this->overlay_row_max_ = this->dirty_row_max_;
+  this->overlay_col_min_ = this->dirty_col_min_, this->overlay_col_max_ = this->dirty_col_max_;
+
+  if (full) {
+    this->mark_dirty_all_();
+    return;
+  }
+  if (restored_rows[0] <= restored_rows[1]) {
+    this->mark_dirty_(restored_rows[0], restored_cols[0]);
+    this->mark_dirty_(restored_rows[1], restored_cols[1]);
+  }
+  if (pending) {
+    this->mark_dirty_(pending_rows[0], pending_cols[0]);
+    this->mark_dirty_(pending_rows[1], pending_cols[1]);
+  }
+}
+
+#ifdef USE_ESP32
+void ST7305RLCD::render_task_fn_(void *arg) {
+  auto *self = static_cast<ST7305RLCD *>(arg);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->render_();
+    // Release: the loop sees the finished frame only after every buffer write
+    self->render_state_.store(ST7305_RENDER_READY, std::memory_order_release);
+  }
+}
+#endif
+
+bool ST7305RLCD::on_render_task_() const {
+#ifdef USE_ESP32
+  return this->render_task_ != nullptr && xTaskGetCurrentTaskHandle() == this->render_task_;
+#else
+  return false;
+#endif
+}
+
+void ST7305RLCD::start_render_() {
+#ifdef USE_ESP32
+  this->render_requested_ = false;
+  this->render_state_.store(ST7305_RENDER_RENDERING, std::memory_order_release);
+  xTaskNotifyGive(this->render_task_);
+#endif
 }
 
+void ST7305RLCD::take_rendered_frame_() {
+  // Copies the dirty window into the front buffer, unless the panel is still waking
+  if (!this->render_queued_) {
+    this->render_queued_ = true;
+    this->queue_write_();
+  }
+  // Deferred until the panel is ready: panel_ready_() sends it and the buffer stays with the loop until then
+  if (this->write_when_ready_)
+    return;
+  this->render_queued_ = false;
+  this->render_state_.store(ST7305_RENDER_IDLE, std::memory_order_release);
+  if (!this->render_requested_)
+    return;
+  // The update() held back while the frame was in flight
+  if (!this->content_changed_()) {
+    this->render_requested_ = false;
+    this->frames_skipped_++;
+    return;
+  }
+  this->start_render_();
+}
+
+void ST7305RLCD::update_strips_() {
+  if (this->buffer_ == nullptr)
+    return;
+  if (this->power_governor_ && this->sleeping_)
+    this->wake();
+  // The buffer only holds one strip, so a frame held back for the panel is re-rendered
+  if (!this->ready_) {
+    this->write_when_ready_ = true;
+    return;
+  }
+  this->prepare_power_for_write_();
+
+  uint32_t render_cycles = 0;
+  this->frame_write_cycles_ = 0;
+  this->flush_buffer_ = this->buffer_;
+  for (uint16_t base = 0; base < this->panel_rows_; base += this->buffer_rows_) {
+    this->strip_base_ = base;
+    // Defined background for lambdas that don't clear (auto_clear_enabled: false)
+    memset(this->buffer_, 0xFF, this->buffer_size_);
+    this->render_();
+    render_cycles += this->render_cycles_;
+    const uint16_t last = std::min<uint16_t>(base + this->buffer_rows_, this->panel_rows_) - 1;
+    this->write_window_(base, last, 0, this->col_end_ - this->col_start_);
+    App.feed_wdt();
+  }
+  this->strip_base_ = 0;
+  this->clear_dirty_();
+  this->render_cycles_ = render_cycles;
+  this->finish_write_();
+}
+
+void ST7305RLCD::queue_write_() {
+  if (this->te_pin_ == nullptr) {
+    this->write_display_();
+    return;
+  }
+  // Hold the frame until the next TE edge; later updates before it coalesce into one transfer
+  if (!this->te_armed_) {
+    this->te_armed_ = true;
+    this->te_armed_at_ = millis();
+    this->te_seen_ = this->te_count_;
+    this->high_freq_.start();
+  }
+}
+
+void IRAM_ATTR ST7305RLCD::te_isr_(ST7305RLCD *arg) { arg->te_count_++; }
+
 void ST7305RLCD::fill(Color color) {
+  if (this->gray_plane_ != nullptr) {
+    const uint8_t level = color_to_ink_(color) >> 6;
+    memset(this->gray_plane_, (level & 1) ? 0x00 : 0xFF, this->buffer_size_);
+    color = (level & 2) ? COLOR_ON : COLOR_OFF;
+  }
   const uint8_t fill_value = (color.is_on()) ? 0x00 : 0xFF;
   memset(this->buffer_, fill_value, this->buffer_size_);
+  this->mark_dirty_all_();
+}
+
+void ST7305RLCD::mark_dirty_all_() {
+  this->dirty_row_min_ = 0;
+  this->dirty_row_max_ = this->buffer_rows_ - 1;
+  this->dirty_col_min_ = 0;
+  this->dirty_col_max_ = this->block_stride_ - 1;
+}
+
+void ST7305RLCD::clear_dirty_() {
+  this->dirty_row_min_ = 0xFFFF;
+  this->dirty_row_max_ = 0;
+  this->dirty_col_min_ = 0xFFFF;
+  this->dirty_col_max_ = 0;
 }
 
 void ST7305RLCD::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return;
 
-  // O(1) lookup using precomputed tables
-  const uint32_t pixel_idx = static_cast<uint32_t>(x) * this->height_ + y;
-  const uint16_t buffer_idx = this->pixel_index_lut_[pixel_idx];
-  const uint8_t bit_mask = this->pixel_bit_lut_[pixel_idx];
-
-  if (color.is_on()) {
-    this->buffer_[buffer_idx] &= ~bit_mask;  // Black = bit clear
+  // O(1) arithmetic addressing, no table reads. Changed bytes extend the dirty region.
+  if (this->orientation_ == ST7305_ORIENTATION_LANDSCAPE) {
+    this->set_pixel_<ST7305_ORIENTATION_LANDSCAPE>(x, y, color.is_on());
   } else {
-    this->buffer_[buffer_idx] |= bit_mask;   // White = bit set
+    this->set_pixel_<ST7305_ORIENTATION_PORTRAIT>(x, y, color.is_on());
+  }
+}
+
+void ST7305_HOT ST7305RLCD::draw_pixel_at(int x, int y, Color color) {
+  this->pixel_calls_++;
+  // get_clipping() and Rect::inside() live in flash, only consult them while a clip is set
+  if (this->is_clipping() && !this->get_clipping().inside(x, y))
+    return;
+  // Rotation may be changed at runtime through set_rotation(); the table lookup only runs then
+  if (this->pixel_fn_ == nullptr || this->rotation_ != this->pixel_fn_rotation_)
+    this->select_pixel_fn_();
+  if (this->gray_plane_ != nullptr) {
+    // Frame modulation: 2-bit level, LSB plane first, then the MSB plane in buffer_
+    const uint8_t level = color_to_ink_(color) >> 6;
+    this->on_gray_plane_([&]() { (this->*pixel_fn_)(x, y, (level & 1) ? COLOR_ON : COLOR_OFF); });
+    color = (level & 2) ? COLOR_ON : COLOR_OFF;
+  }
+  (this->*pixel_fn_)(x, y, color);
+  // Every ST7305_WDT_PIXELS calls, only on the loop task (the one subscribed to the task watchdog)
+  if ((this->pixel_calls_ & (ST7305_WDT_PIXELS - 1)) == 0 && !this->on_render_task_())
+    App.feed_wdt();
+}
+
+void ST7305RLCD::select_pixel_fn_() {
+  using PixelFn = void (ST7305RLCD::*)(int, int, Color);
+  using display::DISPLAY_ROTATION_0_DEGREES;
+  using display::DISPLAY_ROTATION_90_DEGREES;
+  using display::DISPLAY_ROTATION_180_DEGREES;
+  using display::DISPLAY_ROTATION_270_DEGREES;
+#define ST7305_PIXEL_FNS(O, D) \
+  { \
+    &ST7305RLCD::draw_rotated_pixel_<O, DISPLAY_ROTATION_0_DEGREES, D>, \
+        &ST7305RLCD::draw_rotated_pixel_<O, DISPLAY_ROTATION_90_DEGREES, D>, \
+        &ST7305RLCD::draw_rotated_pixel_<O, DISPLAY_ROTATION_180_DEGREES, D>, \
+        &ST7305RLCD::draw_rotated_pixel_<O, DISPLAY_ROTATION_270_DEGREES, D>, \
   }
+  // [orientation][dithered][rotation / 90]
+  static const PixelFn PIXEL_FNS[2][2][4] = {
+      {ST7305_PIXEL_FNS(ST7305_ORIENTATION_LANDSCAPE, false), ST7305_PIXEL_FNS(ST7305_ORIENTATION_LANDSCAPE, true)},
+      {ST7305_PIXEL_FNS(ST7305_ORIENTATION_PORTRAIT, false), ST7305_PIXEL_FNS(ST7305_ORIENTATION_PORTRAIT, true)},
+  };
+#undef ST7305_PIXEL_FNS
+
+  const uint8_t dithered = this->dither_ != ST7305_DITHER_NONE ? 1 : 0;
+  this->pixel_fn_ = PIXEL_FNS[this->orientation_][dithered][(this->rotation_ / 90) & 3];
+  this->pixel_fn_rotation_ = this->rotation_;
 }
 
 // =============================================================================
-// Hardware Initialization
+// Block Operations
 // =============================================================================
 
-void ST7305RLCD::hardware_reset_() {
-  if (this->reset_pin_ == nullptr)
-    return;
+bool ST7305_HOT ST7305RLCD::clip_to_absolute_(int &x0, int &y0, int &x1, int &y1) {
+  // Clip in user coordinates first, exactly like DisplayBuffer::draw_pixel_at()
+  if (this->is_clipping()) {
+    const display::Rect clip = this->get_clipping();
+    x0 = std::max<int>(x0, clip.x);
+    y0 = std::max<int>(y0, clip.y);
+    x1 = std::min<int>(x1, clip.x2() - 1);
+    y1 = std::min<int>(y1, clip.y2() - 1);
+  }
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, this->get_width() - 1);
+  y1 = std::min(y1, this->get_height() - 1);
+  if (x0 > x1 || y0 > y1)
+    return false;
+
+  // Same transforms as DisplayBuffer::draw_pixel_at(), applied to both corners
+  const int w = this->width_, h = this->height_;
+  int ax0, ay0, ax1, ay1;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_90_DEGREES:
+      ax0 = w - 1 - y1, ax1 = w - 1 - y0, ay0 = x0, ay1 = x1;
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      ax0 = w - 1 - x1, ax1 = w - 1 - x0, ay0 = h - 1 - y1, ay1 = h - 1 - y0;
+      break;
+    case display::DISPLAY_ROTATION_270_DEGREES:
+      ax0 = y0, ax1 = y1, ay0 = h - 1 - x1, ay1 = h - 1 - x0;
+      break;
+    default:
+      ax0 = x0, ax1 = x1, ay0 = y0, ay1 = y1;
+      break;
+  }
+  x0 = ax0, y0 = ay0, x1 = ax1, y1 = ay1;
+
+  // Strip mode: only the panel RAM rows resident in the buffer can be drawn
+  if (this->strip_rows_ != 0) {
+    int &major0 = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE ? x0 : y0;
+    int &major1 = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE ? x1 : y1;
+    major0 = std::max<int>(major0, this->strip_base_ * 2);
+    major1 = std::min<int>(major1, (this->strip_base_ + this->buffer_rows_) * 2 - 1);
+    if (major0 > major1)
+      return false;
+  }
+  return true;
+}
 
-  // Hardware reset timing per ST7305 datasheet.
-  // These delays are acceptable as they only occur during setup().
-  this->reset_pin_->digital_write(true);
-  delay(50);
-  this->reset_pin_->digital_write(false);
-  delay(20);
-  this->reset_pin_->digital_write(true);
-  delay(50);
+uint8_t ST7305_HOT ST7305RLCD::block_mask_(uint8_t m0, uint8_t m1, uint8_t n0, uint8_t n1) const {
+  // Each byte holds 2 pixels along the major axis (m) and 4 along the minor axis (n)
+  uint8_t mask = 0;
+  for (uint8_t m = m0; m <= m1; m++) {
+    for (uint8_t n = n0; n <= n1; n++) {
+      if (this->orientation_ == ST7305_ORIENTATION_LANDSCAPE) {
+        mask |= 0x80 >> ((n << 1) | m);
+      } else {
+        mask |= 0x80 >> ((m << 2) | n);
+      }
+    }
+  }
+  return mask;
 }
 
-void ST7305RLCD::init_display_() {
-  // Initialization sequence from Waveshare reference driver
-  // Most commands are common across ST7305 panels
+void ST7305_HOT ST7305RLCD::absolute_to_axes_(int x0, int y0, int x1, int y1, int &major0, int &major1,
+                                              int &minor0, int &minor1) const {
+  // Major axis runs across panel RAM rows (2 pixels each), minor axis across bytes (4 pixels each)
+  if (this->orientation_ == ST7305_ORIENTATION_LANDSCAPE) {
+    major0 = x0, major1 = x1;
+    minor0 = this->height_ - 1 - y1, minor1 = this->height_ - 1 - y0;
+  } else {
+    major0 = y0, major1 = y1;
+    minor0 = x0, minor1 = x1;
+  }
+}
 
-  // NVM Load Control - Load settings from non-volatile memory
-  this->send_command_(0xD6);
-  this->send_data_(0x17);
-  this->send_data_(0x02);
-
-  // Booster Enable - Enable charge pump
-  this->send_command_(0xD1);
-  this->send_data_(0x01);
-
-  // Gate Voltage Setting - VGH/VGL voltages
-  this->send_command_(0xC0);
-  this->send_data_(0x11);
-  this->send_data_(0x04);
-
-  // VSHP Setting - Positive source voltage (high power mode)
-  this->send_command_(0xC1);
-  this->send_data_(0x69);
-  this->send_data_(0x69);
-  this->send_data_(0x69);
-  this->send_data_(0x69);
-
-  // VSLP Setting - Positive source voltage (low power mode)
-  this->send_command_(0xC2);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-
-  // VSHN Setting - Negative source voltage (high power mode)
-  this->send_command_(0xC4);
-  this->send_data_(0x4B);
-  this->send_data_(0x4B);
-  this->send_data_(0x4B);
-  this->send_data_(0x4B);
-
-  // VSLN Setting - Negative source voltage (low power mode)
-  this->send_command_(0xC5);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-  this->send_data_(0x19);
-
-  // OSC Setting - Oscillator frequency control
-  this->send_command_(0xD8);
-  this->send_data_(0x80);
-  this->send_data_(0xE9);
-
-  // Frame Rate Control
-  this->send_command_(0xB2);
-  this->send_data_(0x02);
-
-  // Gate EQ Control (High Power Mode) - Update period timing
-  this->send_command_(0xB3);
-  this->send_data_(0xE5);
-  this->send_data_(0xF6);
-  this->send_data_(0x05);
-  this->send_data_(0x46);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x76);
-  this->send_data_(0x45);
-
-  // Gate EQ Control (Low Power Mode) - Update period timing
-  this->send_command_(0xB4);
-  this->send_data_(0x05);
-  this->send_data_(0x46);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x77);
-  this->send_data_(0x76);
-  this->send_data_(0x45);
-
-  // Gate Timing Control
-  this->send_command_(0x62);
-  this->send_data_(0x32);
-  this->send_data_(0x03);
-  this->send_data_(0x1F);
-
-  // Source EQ Enable
-  this->send_command_(0xB7);
-  this->send_data_(0x13);
+template<typename F> void ST7305_HOT ST7305RLCD::for_each_block_run_(int x0, int y0, int x1, int y1, F &&op) {
+  int major0, major1, minor0, minor1;
+  this->absolute_to_axes_(x0, y0, x1, y1, major0, major1, minor0, minor1);
 
-  // Gate Line Setting - Number of gate lines (panel-specific)
-  this->send_command_(0xB0);
-  if (this->model_ == ST7305_MODEL_WAVESHARE_400X300) {
-    this->send_data_(0x64);  // 100 * 3 = 300 lines
-  } else if (this->model_ == ST7305_MODEL_OSPTEK_200X200) {
-    this->send_data_(0x32);  // 50 * 4 = 200 lines
-  } else {
-    // Custom: calculate based on height
-    this->send_data_(static_cast<uint8_t>(this->height_ / 3));
+  // Buffer-relative rows (strip mode offsets them by strip_base_, clip_to_absolute_() kept them resident)
+  const uint16_t row_first = (major0 >> 1) - this->strip_base_, row_last = (major1 >> 1) - this->strip_base_;
+  const uint16_t col_first = minor0 >> 2, col_last = minor1 >> 2;
+  const uint8_t n_first = minor0 & 3, n_last = minor1 & 3;
+
+  for (uint16_t row = row_first; row <= row_last; row++) {
+    const uint8_t m0 = (row == row_first) ? (major0 & 1) : 0;
+    const uint8_t m1 = (row == row_last) ? (major1 & 1) : 1;
+    uint8_t *bytes = this->buffer_ + static_cast<uint32_t>(row) * this->block_stride_ + col_first;
+
+    if (col_first == col_last) {
+      op(bytes, 1, this->block_mask_(m0, m1, n_first, n_last));
+      continue;
+    }
+    op(bytes, 1, this->block_mask_(m0, m1, n_first, 3));
+    if (col_last - col_first > 1)
+      op(bytes + 1, col_last - col_first - 1, this->block_mask_(m0, m1, 0, 3));
+    op(bytes + (col_last - col_first), 1, this->block_mask_(m0, m1, 0, n_last));
   }
 
-  // Sleep Out - Exit sleep mode (required delay per datasheet, acceptable during setup)
-  this->send_command_(0x11);
-  delay(200);
+  this->mark_dirty_(row_first, col_first);
+  this->mark_dirty_(row_last, col_last);
+}
+
+void ST7305_HOT ST7305RLCD::fill_rect(int x, int y, int width, int height, Color color) {
+  if (this->buffer_ == nullptr || width <= 0 || height <= 0)
+    return;
+  int x0 = x, y0 = y, x1 = x + width - 1, y1 = y + height - 1;
+  if (!this->clip_to_absolute_(x0, y0, x1, y1))
+    return;
 
-  // Source Voltage Select - Use VSHP1/VSLP1/VSHN1/VSLN1
-  this->send_command_(0xC9);
-  this->send_data_(0x00);
+  // The lambdas are functions of their own, placed next to the span loop
+  auto fill = [&](bool on) ST7305_HOT {
+    this->for_each_block_run_(x0, y0, x1, y1, [on](uint8_t *bytes, uint16_t count, uint8_t mask) ST7305_HOT {
+      if (mask == 0xFF) {
+        memset(bytes, on ? 0x00 : 0xFF, count);  // Black = bit clear
+        return;
+      }
+      for (uint16_t i = 0; i < count; i++) {
+        bytes[i] = on ? (bytes[i] & ~mask) : (bytes[i] | mask);
+      }
+    });
+  };
+
+  if (this->gray_plane_ != nullptr) {
+    const uint8_t level = color_to_ink_(color) >> 6;
+    this->on_gray_plane_([&]() { fill(level & 1); });
+    fill(level & 2);
+    return;
+  }
+  fill(color.is_on());
+}
 
-  // Memory Data Access Control (MADCTL) - MX=1, DO=1
-  this->send_command_(0x36);
-  this->send_data_(0x48);
+template<typename F> void ST7305RLCD::blit_blocks_(int x, int y, int width, int height, F &&pixel) {
+  if (this->buffer_ == nullptr || width <= 0 || height <= 0)
+    return;
+  int ax0 = x, ay0 = y, ax1 = x + width - 1, ay1 = y + height - 1;
+  if (!this->clip_to_absolute_(ax0, ay0, ax1, ay1))
+    return;
+
+  // Absolute -> source coordinates as an affine map: s = base + ax * d_x + ay * d_y
+  const int w = this->width_, h = this->height_;
+  int sx_base, sx_dx, sx_dy, sy_base, sy_dx, sy_dy;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_90_DEGREES:  // user = (ay, w - 1 - ax)
+      sx_base = -x, sx_dx = 0, sx_dy = 1, sy_base = w - 1 - y, sy_dx = -1, sy_dy = 0;
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:  // user = (w - 1 - ax, h - 1 - ay)
+      sx_base = w - 1 - x, sx_dx = -1, sx_dy = 0, sy_base = h - 1 - y, sy_dx = 0, sy_dy = -1;
+      break;
+    case display::DISPLAY_ROTATION_270_DEGREES:  // user = (h - 1 - ay, ax)
+      sx_base = h - 1 - x, sx_dx = 0, sx_dy = -1, sy_base = -y, sy_dx = 1, sy_dy = 0;
+      break;
+    default:
+      sx_base = -x, sx_dx = 1, sx_dy = 0, sy_base = -y, sy_dx = 0, sy_dy = 1;
+      break;
+  }
 
-  // Data Format Select - 1-bit monochrome mode
-  this->send_command_(0x3A);
-  this->send_data_(0x11);
+  const bool landscape = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE;
+  int major0, major1, minor0, minor1;
+  if (landscape) {
+    major0 = ax0, major1 = ax1, minor0 = h - 1 - ay1, minor1 = h - 1 - ay0;
+  } else {
+    major0 = ay0, major1 = ay1, minor0 = ax0, minor1 = ax1;
+  }
 
-  // Gamma Mode Setting - Monochrome mode
-  this->send_command_(0xB9);
-  this->send_data_(0x20);
+  for (int row = major0 >> 1; row <= (major1 >> 1); row++) {
+    uint8_t *bytes = this->buffer_ + static_cast<uint32_t>(row - this->strip_base_) * this->block_stride_;
+    for (int col = minor0 >> 2; col <= (minor1 >> 2); col++) {
+      // Gather the block's pixels from the source, then write the byte once
+      uint8_t draw = 0, black = 0;
+      for (uint8_t m = 0; m < 2; m++) {
+        const int major = (row << 1) + m;
+        if (major < major0 || major > major1)
+          continue;
+        for (uint8_t n = 0; n < 4; n++) {
+          const int minor = (col << 2) + n;
+          if (minor < minor0 || minor > minor1)
+            continue;
+          const int ax = landscape ? major : minor;
+          const int ay = landscape ? h - 1 - minor : major;
+          const int8_t value = pixel(sx_base + ax * sx_dx + ay * sx_dy, sy_base + ax * sy_dx + ay * sy_dy, ax, ay);
+          if (value < 0)
+            continue;
+          const uint8_t bit = landscape ? (0x80 >> ((n << 1) | m)) : (0x80 >> ((m << 2) | n));
+          draw |= bit;
+          if (value > 0)
+            black |= bit;
+        }
+      }
+      bytes[col] = (bytes[col] & ~draw) | (draw & ~black);  // Black = bit clear
+    }
+  }
 
-  // Panel Setting - 1-dot inversion, frame inversion, interlace
-  this->send_command_(0xB8);
-  this->send_data_(0x29);
+  this->mark_dirty_((major0 >> 1) - this->strip_base_, minor0 >> 2);
+  this->mark_dirty_((major1 >> 1) - this->strip_base_, minor1 >> 2);
+}
 
-  // Display Inversion On
-  this->send_command_(0x21);
+void ST7305RLCD::draw_bitmap(int x, int y, int width, int height, const uint8_t *data, Color color,
+                             Color background, bool transparent) {
+  if (data == nullptr)
+    return;
+  const uint16_t src_stride = (width + 7) >> 3;
+  const int8_t fg = color.is_on() ? 1 : 0;
+  const int8_t bg = transparent ? -1 : (background.is_on() ? 1 : 0);
+  auto blit = [&]() {
+    this->blit_blocks_(x, y, width, height, [=](int sx, int sy, int, int) -> int8_t {
+      return (data[sy * src_stride + (sx >> 3)] & (0x80 >> (sx & 7))) ? fg : bg;
+    });
+  };
+  // Frame modulation: bitmaps are full black / white, identical in both planes
+  if (this->gray_plane_ != nullptr)
+    this->on_gray_plane_(blit);
+  blit();
+}
 
-  // Column Address Set - Panel specific
-  this->send_command_(0x2A);
-  this->send_data_(this->col_start_);
-  this->send_data_(this->col_end_);
+void ST7305RLCD::draw_grayscale(int x, int y, int width, int height, const uint8_t *luminance,
+                                ST7305DitherMode mode) {
+  if (this->buffer_ == nullptr || luminance == nullptr || width <= 0 || height <= 0)
+    return;
 
-  // Row Address Set - Panel specific
-  this->send_command_(0x2B);
-  this->send_data_(this->row_start_);
-  this->send_data_(this->row_end_);
+  if (this->gray_plane_ != nullptr) {
+    // Frame modulation shows 4 real levels, quantize instead of dithering
+    this->on_gray_plane_([&]() {
+      this->blit_blocks_(x, y, width, height, [=](int sx, int sy, int, int) -> int8_t {
+        return ((255 - luminance[sy * width + sx]) >> 6) & 1;
+      });
+    });
+    this->blit_blocks_(x, y, width, height, [=](int sx, int sy, int, int) -> int8_t {
+      return ((255 - luminance[sy * width + sx]) >> 7) & 1;
+    });
+    return;
+  }
 
-  // Tearing Effect Line On
-  this->send_command_(0x35);
-  this->send_data_(0x00);
+  if (mode == ST7305_DITHER_NONE) {
+    this->blit_blocks_(x, y, width, height, [=](int sx, int sy, int, int) -> int8_t {
+      return luminance[sy * width + sx] < 128 ? 1 : 0;
+    });
+    return;
+  }
 
-  // Auto Power Down Control
-  this->send_command_(0xD0);
-  this->send_data_(0xFF);
+  if (mode == ST7305_DITHER_BAYER) {
+    // Threshold anchored to absolute coordinates, so it lines up with dithered draw_pixel_at()
+    this->blit_blocks_(x, y, width, height, [=](int sx, int sy, int ax, int ay) -> int8_t {
+      return (255 - luminance[sy * width + sx]) > ST7305_BAYER_4X4[ay & 3][ax & 3] ? 1 : 0;
+    });
+    return;
+  }
 
-  // High Power Mode On
-  this->send_command_(0x38);
+  // Floyd-Steinberg: error of the current and next source row, padded by one on each side
+  std::vector<int16_t> errors(2 * (width + 2), 0);
+  int16_t *cur = errors.data() + 1;
+  int16_t *next = errors.data() + width + 3;
+  for (int sy = 0; sy < height; sy++) {
+    const uint8_t *src = luminance + sy * width;
+    for (int sx = 0; sx < width; sx++) {
+      const int16_t value = src[sx] + cur[sx];
+      const bool black = value < 128;
+      const int16_t error = value - (black ? 0 : 255);
+      cur[sx + 1] += (error * 7) >> 4;
+      next[sx - 1] += (error * 3) >> 4;
+      next[sx] += (error * 5) >> 4;
+      next[sx + 1] += error >> 4;
+      this->draw_pixel_at(x + sx, y + sy, black ? COLOR_ON : COLOR_OFF);
+    }
+    std::swap(cur, next);
+    std::fill(next - 1, next + width + 1, 0);
+  }
+}
 
-  // Display On
-  this->send_command_(0x29);
+// Combine count bytes of src into dst under mask, a word at a time once both are word aligned.
+// Buffers come from the heap, so equal offsets into two of them share their alignment.
+template<typename F>
+static inline void ST7305_HOT apply_masked(uint8_t *dst, const uint8_t *src, uint16_t count, uint8_t mask, F &&op) {
+  uint16_t i = 0;
+  for (; i < count && (reinterpret_cast<uintptr_t>(dst + i) & 3) != 0; i++)
+    dst[i] = (dst[i] & ~mask) | (op(dst[i], src[i]) & mask);
+  if ((reinterpret_cast<uintptr_t>(src + i) & 3) == 0) {
+    const uint32_t wide_mask = mask * 0x01010101u;
+    for (; i + 4 <= count; i += 4) {
+      uint32_t *word = reinterpret_cast<uint32_t *>(dst + i);
+      const uint32_t source = *reinterpret_cast<const uint32_t *>(src + i);
+      *word = (*word & ~wide_mask) | (op(*word, source) & wide_mask);
+    }
+  }
+  for (; i < count; i++)
+    dst[i] = (dst[i] & ~mask) | (op(dst[i], src[i]) & mask);
 }
 
-// =============================================================================
-// Pixel Lookup Table Initialization
-// =============================================================================
+void ST7305RLCD::invert_rect(int x, int y, int width, int height) {
+  if (this->buffer_ == nullptr || width <= 0 || height <= 0)
+    return;
+  int x0 = x, y0 = y, x1 = x + width - 1, y1 = y + height - 1;
+  if (!this->clip_to_absolute_(x0, y0, x1, y1))
+    return;
 
-void ST7305RLCD::init_pixel_lut_() {
-  const uint32_t total_pixels = static_cast<uint32_t>(this->width_) * this->height_;
+  auto invert = [&]() {
+    this->for_each_block_run_(x0, y0, x1, y1, [](uint8_t *bytes, uint16_t count, uint8_t mask) {
+      apply_masked(bytes, bytes, count, mask, [](uint32_t d, uint32_t) { return ~d; });
+    });
+  };
+  // Both planes: level 3 - n, so black and white swap and the grays swap with each other
+  if (this->gray_plane_ != nullptr)
+    this->on_gray_plane_(invert);
+  invert();
+}
 
-  // Allocate LUTs in PSRAM if available
-  ExternalRAMAllocator<uint16_t> index_allocator(ExternalRAMAllocator<uint16_t>::ALLOW_FAILURE);
-  ExternalRAMAllocator<uint8_t> bit_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+void ST7305RLCD::combine_layer(const uint8_t *layer, ST7305RasterOp op, int x, int y, int width, int height) {
+  if (this->buffer_ == nullptr || layer == nullptr || width <= 0 || height <= 0 || this->strip_rows_ != 0)
+    return;
+  int x0 = x, y0 = y, x1 = x + width - 1, y1 = y + height - 1;
+  if (!this->clip_to_absolute_(x0, y0, x1, y1))
+    return;
 
-  this->pixel_index_lut_ = index_allocator.allocate(total_pixels);
-  this->pixel_bit_lut_ = bit_allocator.allocate(total_pixels);
+  // Black = bit clear, so the black-pixel logic is the dual of the bit logic
+  auto combine = [&](auto &&bits) {
+    this->for_each_block_run_(x0, y0, x1, y1, [&](uint8_t *bytes, uint16_t count, uint8_t mask) {
+      apply_masked(bytes, layer + (bytes - this->buffer_), count, mask, bits);
+    });
+  };
+  auto apply = [&]() {
+    switch (op) {
+      case ST7305_ROP_AND:
+        combine([](uint32_t d, uint32_t s) { return d | s; });
+        break;
+      case ST7305_ROP_OR:
+        combine([](uint32_t d, uint32_t s) { return d & s; });
+        break;
+      case ST7305_ROP_XOR:
+        combine([](uint32_t d, uint32_t s) { return ~(d ^ s); });
+        break;
+      default:
+        combine([](uint32_t, uint32_t s) { return s; });
+        break;
+    }
+  };
+  // Layers are black / white, identical in both planes
+  if (this->gray_plane_ != nullptr)
+    this->on_gray_plane_(apply);
+  apply();
+}
 
-  if (this->pixel_index_lut_ == nullptr || this->pixel_bit_lut_ == nullptr) {
-    ESP_LOGE(TAG, "Failed to allocate LUTs for %u pixels", total_pixels);
+void ST7305RLCD::copy_rect(int src_x, int src_y, int width, int height, int dst_x, int dst_y) {
+  if (this->buffer_ == nullptr || width <= 0 || height <= 0)
+    return;
+  if (this->strip_rows_ != 0) {
+    ESP_LOGW(TAG, "Strip mode keeps no framebuffer to copy from");
     return;
   }
 
-  ESP_LOGD(TAG, "Building pixel LUTs for %ux%u (%s)...",
-           this->width_, this->height_,
-           this->orientation_ == ST7305_ORIENTATION_LANDSCAPE ? "landscape" : "portrait");
+  // Only on-screen source pixels can be copied
+  const int screen_width = this->get_width(), screen_height = this->get_height();
+  if (src_x < 0)
+    dst_x -= src_x, width += src_x, src_x = 0;
+  if (src_y < 0)
+    dst_y -= src_y, height += src_y, src_y = 0;
+  width = std::min(width, screen_width - src_x);
+  height = std::min(height, screen_height - src_y);
+  if (width <= 0 || height <= 0)
+    return;
+
+  // The move in panel axes: user offset -> absolute (same transforms as clip_to_absolute_()) -> major / minor
+  const int dx = dst_x - src_x, dy = dst_y - src_y;
+  int dax, day;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_90_DEGREES:
+      dax = -dy, day = dx;
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      dax = -dx, day = -dy;
+      break;
+    case display::DISPLAY_ROTATION_270_DEGREES:
+      dax = dy, day = -dx;
+      break;
+    default:
+      dax = dx, day = dy;
+      break;
+  }
+  const bool landscape = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE;
+  const int shift_major = landscape ? dax : day, shift_minor = landscape ? -day : dax;
+
+  if ((shift_major & 1) == 0 && (shift_minor & 3) == 0) {
+    // Block aligned: every destination byte comes from one source byte. The source bytes
+    // are staged first, so overlapping rectangles need no particular copy order.
+    int x0 = dst_x, y0 = dst_y, x1 = dst_x + width - 1, y1 = dst_y + height - 1;
+    if (!this->clip_to_absolute_(x0, y0, x1, y1))
+      return;
+    int major0, major1, minor0, minor1;
+    this->absolute_to_axes_(x0, y0, x1, y1, major0, major1, minor0, minor1);
+    const int row_first = major0 >> 1, col_first = minor0 >> 2;
+    const int rows = (major1 >> 1) - row_first + 1, cols = (minor1 >> 2) - col_first + 1;
+    const int row_shift = shift_major >> 1, col_shift = shift_minor >> 2;
+    std::vector<uint8_t> staged(static_cast<size_t>(rows) * cols);
+
+    auto copy = [&]() {
+      for (int row = 0; row < rows; row++) {
+        const uint32_t src = static_cast<uint32_t>(row_first + row - row_shift) * this->block_stride_ + col_first - col_shift;
+        memcpy(staged.data() + row * cols, this->buffer_ + src, cols);
+      }
+      this->for_each_block_run_(x0, y0, x1, y1, [&](uint8_t *bytes, uint16_t count, uint8_t mask) {
+        const uint32_t offset = bytes - this->buffer_;
+        const int row = offset / this->block_stride_ - row_first, col = offset % this->block_stride_ - col_first;
+        apply_masked(bytes, staged.data() + row * cols + col, count, mask, [](uint32_t, uint32_t s) { return s; });
+      });
+    };
+    if (this->gray_plane_ != nullptr)
+      this->on_gray_plane_(copy);
+    copy();
+    return;
+  }
+
+  // Unaligned: read the source into a 1-bpp bitmap and blit it, pixel by pixel
+  const uint16_t stride = (width + 7) >> 3;
+  std::vector<uint8_t> bits(static_cast<size_t>(stride) * height);
+  auto copy = [&]() {
+    std::fill(bits.begin(), bits.end(), 0);
+    for (int sy = 0; sy < height; sy++) {
+      for (int sx = 0; sx < width; sx++) {
+        if (this->is_black_(src_x + sx, src_y + sy))
+          bits[sy * stride + (sx >> 3)] |= 0x80 >> (sx & 7);
+      }
+    }
+    this->blit_blocks_(dst_x, dst_y, width, height, [&](int sx, int sy, int, int) -> int8_t {
+      return (bits[sy * stride + (sx >> 3)] & (0x80 >> (sx & 7))) ? 1 : 0;
+    });
+  };
+  if (this->gray_plane_ != nullptr)
+    this->on_gray_plane_(copy);
+  copy();
+}
+
+void ST7305RLCD::invalidate_background() {
+  this->background_valid_ = false;
+}
 
+uint8_t *ST7305RLCD::create_layer() {
+  if (this->strip_rows_ != 0 || this->buffer_size_ == 0)
+    return nullptr;
+  uint8_t *layer = this->allocate_buffer_(this->buffer_size_);
+  if (layer == nullptr) {
+    ESP_LOGW(TAG, "Failed to allocate layer (%zu bytes)", this->buffer_size_);
+    return nullptr;
+  }
+  memset(layer, 0xFF, this->buffer_size_);
+  return layer;
+}
+
+bool ST7305RLCD::is_black_(int x, int y) const {
+  int ax, ay;
+  switch (this->rotation_) {
+    case display::DISPLAY_ROTATION_90_DEGREES:
+      ax = this->width_ - 1 - y, ay = x;
+      break;
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      ax = this->width_ - 1 - x, ay = this->height_ - 1 - y;
+      break;
+    case display::DISPLAY_ROTATION_270_DEGREES:
+      ax = y, ay = this->height_ - 1 - x;
+      break;
+    default:
+      ax = x, ay = y;
+      break;
+  }
+  uint16_t row, col;
+  uint8_t mask;
   if (this->orientation_ == ST7305_ORIENTATION_LANDSCAPE) {
-    this->init_lut_landscape_();
+    this->locate_<ST7305_ORIENTATION_LANDSCAPE>(ax, ay, row, col, mask);
   } else {
-    this->init_lut_portrait_();
+    this->locate_<ST7305_ORIENTATION_PORTRAIT>(ax, ay, row, col, mask);
   }
-
-  ESP_LOGD(TAG, "LUT initialization complete");
+  return (this->buffer_[static_cast<uint32_t>(row) * this->block_stride_ + col] & mask) == 0;
 }
 
-void ST7305RLCD::init_lut_landscape_() {
-  // Landscape orientation: 2×4 pixel blocks
-  // Reference: Waveshare InitLandscapeLUT() in custom_lcd_display.cc
-  //
-  // Each byte contains 8 pixels (2 columns × 4 rows):
-  // - Bit 7: (row 0, col 0), Bit 6: (row 0, col 1)
-  // - Bit 5: (row 1, col 0), Bit 4: (row 1, col 1)
-  // - Bit 3: (row 2, col 0), Bit 2: (row 2, col 1)
-  // - Bit 1: (row 3, col 0), Bit 0: (row 3, col 1)
+void ST7305RLCD::scroll(int lines, Color fill) {
+  if (this->buffer_ == nullptr || lines == 0)
+    return;
+  if (this->strip_rows_ != 0) {
+    ESP_LOGW(TAG, "Strip mode keeps no framebuffer to scroll");
+    return;
+  }
 
-  const uint16_t H4 = this->height_ >> 2;  // Vertical blocks (height/4)
+  const int screen_height = this->get_height();
+  const int top = std::max(this->scroll_top_, 0);
+  const int bottom = this->scroll_height_ > 0 ? std::min(top + this->scroll_height_, screen_height) : screen_height;
+  const int height = bottom - top;
+  if (height <= 0)
+    return;
 
-  for (uint16_t y = 0; y < this->height_; y++) {
-    const uint16_t inv_y = this->height_ - 1 - y;
-    const uint16_t block_y = inv_y >> 2;
-    const uint8_t local_y = inv_y & 3;
+  if (std::abs(lines) < height) {
+    // User row u lands on buffer axis position base + sign * u: pick the axis and direction for this rotation.
+    // Landscape: absolute x runs across RAM rows (major), absolute y along them reversed (minor).
+    // Portrait: absolute y is major, absolute x is minor.
+    const bool landscape = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE;
+    const int w = this->width_, h = this->height_;
+    bool major;
+    int base, sign;
+    switch (this->rotation_) {
+      case display::DISPLAY_ROTATION_90_DEGREES:  // ax = w - 1 - u
+        major = landscape, base = w - 1, sign = -1;
+        break;
+      case display::DISPLAY_ROTATION_180_DEGREES:  // ay = h - 1 - u
+        major = !landscape, base = landscape ? 0 : h - 1, sign = landscape ? 1 : -1;
+        break;
+      case display::DISPLAY_ROTATION_270_DEGREES:  // ax = u
+        major = landscape, base = 0, sign = 1;
+        break;
+      default:  // ay = u
+        major = !landscape, base = landscape ? h - 1 : 0, sign = landscape ? -1 : 1;
+        break;
+    }
+    const int p0 = base + sign * top, p1 = base + sign * (bottom - 1);
+    this->shift_axis_(major, std::min(p0, p1), std::max(p0, p1), sign * lines);
+    if (this->gray_plane_ != nullptr)
+      this->on_gray_plane_([&]() { this->shift_axis_(major, std::min(p0, p1), std::max(p0, p1), sign * lines); });
+
+    // The content moved, the whole area has to go out again (diff_updates trims unchanged bytes)
+    if (major) {
+      this->mark_dirty_(std::min(p0, p1) >> 1, 0);
+      this->mark_dirty_(std::max(p0, p1) >> 1, this->block_stride_ - 1);
+    } else {
+      this->mark_dirty_(0, std::min(p0, p1) >> 2);
+      this->mark_dirty_(this->buffer_rows_ - 1, std::max(p0, p1) >> 2);
+    }
+  }
 
-    for (uint16_t x = 0; x < this->width_; x++) {
-      const uint16_t byte_x = x >> 1;
-      const uint8_t local_x = x & 1;
+  // Exposed lines
+  const int exposed = std::min(std::abs(lines), height);
+  this->fill_rect(0, lines > 0 ? bottom - exposed : top, this->get_width(), exposed, fill);
+}
 
-      const uint32_t buffer_idx = byte_x * H4 + block_y;
-      const uint8_t bit = 7 - ((local_y << 1) | local_x);
+void ST7305RLCD::shift_axis_(bool major, int first, int last, int shift) {
+  const uint16_t stride = this->block_stride_;
+  if (major && (first & 1) == 0 && (last & 1) == 1 && (shift & 1) == 0) {
+    // Whole panel RAM rows, contiguous in the buffer
+    const int rows = (last - first + 1) >> 1, delta = shift >> 1, keep = rows - std::abs(delta);
+    const int row_first = first >> 1;
+    const int dst = delta > 0 ? row_first : row_first - delta;
+    const int src = delta > 0 ? row_first + delta : row_first;
+    memmove(this->buffer_ + static_cast<uint32_t>(dst) * stride, this->buffer_ + static_cast<uint32_t>(src) * stride,
+            static_cast<size_t>(keep) * stride);
+    return;
+  }
+  if (!major && (first & 3) == 0 && (last & 3) == 3 && (shift & 3) == 0) {
+    // Whole bytes within every row
+    const int cols = (last - first + 1) >> 2, delta = shift >> 2, keep = cols - std::abs(delta);
+    const int col_first = first >> 2;
+    const int dst = delta > 0 ? col_first : col_first - delta;
+    const int src = delta > 0 ? col_first + delta : col_first;
+    for (uint16_t row = 0; row < this->buffer_rows_; row++) {
+      uint8_t *bytes = this->buffer_ + static_cast<uint32_t>(row) * stride;
+      memmove(bytes + dst, bytes + src, keep);
+    }
+    return;
+  }
 
-      const uint32_t pixel_idx = static_cast<uint32_t>(x) * this->height_ + y;
-      this->pixel_index_lut_[pixel_idx] = buffer_idx;
-      this->pixel_bit_lut_[pixel_idx] = (1 << bit);
+  // Unaligned: move bit by bit, walking away from the side being read so sources are consumed first
+  const bool landscape = this->orientation_ == ST7305_ORIENTATION_LANDSCAPE;
+  const int other_extent = major ? stride * 4 : this->buffer_rows_ * 2;
+  auto locate = [&](int p, int q, uint32_t &index, uint8_t &mask) {
+    const int i = major ? p : q, j = major ? q : p;  // major, minor index
+    index = static_cast<uint32_t>(i >> 1) * stride + (j >> 2);
+    mask = landscape ? (0x80 >> (((j & 3) << 1) | (i & 1))) : (0x80 >> (((i & 1) << 2) | (j & 3)));
+  };
+  const int step = shift > 0 ? 1 : -1;
+  const int start = shift > 0 ? first : last, end = shift > 0 ? last - shift : first - shift;
+  for (int p = start; p != end + step; p += step) {
+    for (int q = 0; q < other_extent; q++) {
+      uint32_t src_index, dst_index;
+      uint8_t src_mask, dst_mask;
+      locate(p + shift, q, src_index, src_mask);
+      locate(p, q, dst_index, dst_mask);
+      if (this->buffer_[src_index] & src_mask) {
+        this->buffer_[dst_index] |= dst_mask;
+      } else {
+        this->buffer_[dst_index] &= ~dst_mask;
+      }
     }
   }
 }
 
-void ST7305RLCD::init_lut_portrait_() {
-  // Portrait orientation: 4×2 pixel blocks
-  // Reference: Waveshare InitPortraitLUT()
-  //
-  // Each byte contains 8 pixels (4 columns × 2 rows):
-  //   col0 col1 col2 col3
-  // row0  b7   b6   b5   b4
-  // row1  b3   b2   b1   b0
-  //
-  // Bit position = 7 - (row * 4 + col)
+#ifdef USE_IMAGE
+void ST7305RLCD::draw_image(int x, int y, image::Image *image, Color color, Color background) {
+  if (image->get_type() != image::IMAGE_TYPE_BINARY) {
+    // Grayscale / color images keep ESPHome's per-pixel conversion
+    this->image(x, y, image, color, background);
+    return;
+  }
+  this->draw_bitmap(x, y, image->get_width(), image->get_height(), image->get_data_start(), color, background,
+                    image->has_transparency());
+}
+#endif
+
+#ifdef USE_FONT
+void ST7305RLCD::draw_text(int x, int y, font::Font *font, Color color, display::TextAlign align, const char *text) {
+  int x_at, y_start, width, height;
+  this->get_text_bounds(x, y, text, font, align, &x_at, &y_start, &width, &height);
+  if (font->get_bpp() != 1) {
+    font->print(x_at, y_start, this, color, text, COLOR_OFF);
+    return;
+  }
+
+  const int8_t fg = color.is_on() ? 1 : 0;
+  const auto &glyphs = font->get_glyphs();
+  const uint8_t *str = reinterpret_cast<const uint8_t *>(text);
+  while (*str != '\0') {
+    int match_length;
+    const int glyph_n = font->match_next_glyph(str, &match_length);
+    if (glyph_n < 0) {
+      // Same placeholder as Font::print(): a block the width of the first glyph
+      ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", *str);
+      if (!glyphs.empty()) {
+        const int glyph_width = glyphs[0].get_glyph_data()->width;
+        this->fill_rect(x_at, y_start, glyph_width, font->get_height(), color);
+        x_at += glyph_width;
+      }
+      str++;
+      continue;
+    }
+    const font::GlyphData *glyph = glyphs[glyph_n].get_glyph_data();
+    // Glyph bits run on across rows, no per-row padding
+    const uint8_t *data = glyph->data;
+    const int glyph_width = glyph->width;
+    auto blit = [&]() {
+      this->blit_blocks_(x_at + glyph->offset_x, y_start + glyph->offset_y, glyph->width, glyph->height,
+                         [=](int sx, int sy, int, int) -> int8_t {
+                           const int bit = sy * glyph_width + sx;
+                           return (progmem_read_byte(data + (bit >> 3)) & (0x80 >> (bit & 7))) ? fg : -1;
+                         });
+    };
+    if (this->gray_plane_ != nullptr)
+      this->on_gray_plane_(blit);
+    blit();
+    x_at += glyph->advance;
+    str += match_length;
+  }
+}
+#endif
 
-  const uint16_t W4 = this->width_ >> 2;  // Horizontal blocks (width/4)
+// =============================================================================
+// Hardware Initialization
+// =============================================================================
 
-  for (uint16_t y = 0; y < this->height_; y++) {
-    const uint16_t byte_y = y >> 1;
-    const uint8_t local_y = y & 1;
+void ST7305RLCD::hardware_reset_() {
+  if (this->reset_pin_ == nullptr) {
+    this->init_display_();
+    return;
+  }
 
-    for (uint16_t x = 0; x < this->width_; x++) {
-      const uint16_t byte_x = x >> 2;
-      const uint8_t local_x = x & 3;
+  // Hardware reset timing per ST7305 datasheet: high 50ms, low 20ms, high 50ms, then init
+  this->reset_pin_->digital_write(true);
+  this->set_timeout("reset", 50, [this]() {
+    this->reset_pin_->digital_write(false);
+    this->set_timeout("reset", 20, [this]() {
+      this->reset_pin_->digital_write(true);
+      this->set_timeout("reset", 50, [this]() { this->init_display_(); });
+    });
+  });
+}
 
-      const uint32_t buffer_idx = byte_y * W4 + byte_x;
-      const uint8_t bit = 7 - (local_y * 4 + local_x);
+void ST7305RLCD::init_display_() {
+  if (this->verify_data_rate_)
+    this->verify_data_rate_setup_();
 
-      const uint32_t pixel_idx = static_cast<uint32_t>(x) * this->height_ + y;
-      this->pixel_index_lut_[pixel_idx] = buffer_idx;
-      this->pixel_bit_lut_[pixel_idx] = (1 << bit);
+  // Initialization sequence from Waveshare reference driver
+  // Most commands are common across ST7305 panels
+  this->send_init_sequence_(ST7305_INIT_POWER);
+
+  // Source voltages (panel-specific), same value for all four parameters
+  const uint8_t vshp[] = {this->vshp_, this->vshp_, this->vshp_, this->vshp_};
+  this->send_command_(0xC1, vshp, sizeof(vshp));  // VSHP Setting (high power)
+  const uint8_t vslp[] = {this->vslp_, this->vslp_, this->vslp_, this->vslp_};
+  this->send_command_(0xC2, vslp, sizeof(vslp));  // VSLP Setting (low power)
+  const uint8_t vshn[] = {this->vshn_, this->vshn_, this->vshn_, this->vshn_};
+  this->send_command_(0xC4, vshn, sizeof(vshn));  // VSHN Setting (high power)
+  const uint8_t vsln[] = {this->vsln_, this->vsln_, this->vsln_, this->vsln_};
+  this->send_command_(0xC5, vsln, sizeof(vsln));  // VSLN Setting (low power)
+
+  this->send_init_sequence_(this->timing_sequence_);
+
+  // Gate Line Setting - Number of gate lines (panel-specific)
+  this->send_command_(0xB0, &this->gate_lines_, 1);
+
+  // Sleep Out - Exit sleep mode, the rest of the sequence follows the datasheet delay
+  this->send_command_(0x11);
+  this->set_timeout("init", 200, [this]() { this->finish_init_(); });
+}
+
+void ST7305RLCD::finish_init_() {
+  this->send_init_sequence_(ST7305_INIT_DISPLAY);
+
+  // Column / Row Address Set - Panel specific
+  const uint8_t cols[] = {this->col_start_, this->col_end_};
+  this->send_command_(0x2A, cols, sizeof(cols));
+  const uint8_t rows[] = {this->row_start_, this->row_end_};
+  this->send_command_(0x2B, rows, sizeof(rows));
+
+  this->send_init_sequence_(ST7305_INIT_ENABLE);
+  ESP_LOGD(TAG, "Panel initialized");
+  this->panel_ready_();
+
+  // Give the boot log a moment to settle before hogging the loop
+  if (this->benchmark_on_boot_)
+    this->set_timeout("benchmark", 1000, [this]() { this->run_benchmark(); });
+}
+
+bool ST7305RLCD::resume_panel_() {
+  // One shot: a crash after this point must not resume from a stale record
+  const ST7305PanelState state = st7305_panel_state;
+  st7305_panel_state.magic = 0;
+  if (state.magic != ST7305_PANEL_STATE_MAGIC || state.geometry != this->snapshot_geometry_())
+    return false;
+#ifdef USE_ESP32
+  // RTC memory only means something after deep sleep; any other reset may have cut the panel's power too
+  if (esp_reset_reason() != ESP_RST_DEEPSLEEP)
+    return false;
+#endif
+
+  this->low_power_ = state.low_power;
+  // Display Off survives too; the next write turns it back on
+  this->display_off_ = state.display_off;
+  // The restored snapshot is already on the panel, start diffing against it
+  if (this->snapshot_restored_ && state.in_sync) {
+    this->clear_dirty_();
+    if (this->shadow_buffer_ != nullptr) {
+      memcpy(this->shadow_buffer_, this->buffer_, this->buffer_size_);
+      this->shadow_valid_ = true;
     }
   }
+  ESP_LOGD(TAG, "Resuming panel%s%s", state.sleeping ? " from sleep" : "", this->is_dirty_() ? "" : ", RAM in sync");
+
+  this->resumed_ = true;
+  if (state.sleeping) {
+    // Register state survives Sleep In, only the sleep-out delay is left
+    this->ready_ = true;
+    this->sleeping_ = true;
+    this->wake();
+  } else {
+    this->panel_ready_();
+  }
+  if (this->benchmark_on_boot_)
+    this->set_timeout("benchmark", 1000, [this]() { this->run_benchmark(); });
+  return true;
+}
+
+void ST7305RLCD::panel_ready_() {
+  this->ready_ = true;
+  // Send whatever was drawn while the panel was resetting or waking
+  if (this->write_when_ready_) {
+    this->write_when_ready_ = false;
+    if (this->strip_rows_ != 0) {
+      this->update_strips_();
+    } else {
+      this->queue_write_();
+    }
+  }
+  if (this->sleep_when_ready_) {
+    this->sleep_when_ready_ = false;
+    this->sleep();
+  }
 }
 
 // =============================================================================
@@ -433,19 +1552,292 @@ void ST7305RLCD::write_display_() {
   if (this->buffer_ == nullptr)
     return;
 
-  // Ensure display is awake
-  this->send_command_(0x38);  // High Power Mode
-  this->send_command_(0x29);  // Display On
+  // Nothing touched since the last write, panel RAM is already current
+  if (!this->is_dirty_()) {
+    this->frames_skipped_++;
+    return;
+  }
+
+  // A window is still streaming out (panel_ready_() after a mid-flush wake, for one);
+  // restarting would overwrite the flush state, so flush_done_() sends this frame after it
+  if (this->flushing_) {
+    this->write_pending_ = true;
+    return;
+  }
 
-  // Set column address window
-  this->send_command_(0x2A);
-  this->send_data_(this->col_start_);
-  this->send_data_(this->col_end_);
+  // The governor wakes a sleeping panel on the next frame
+  if (this->power_governor_ && this->sleeping_)
+    this->wake();
+  // Still resetting or waking: keep the frame in the buffer and send it once ready
+  if (!this->ready_) {
+    this->write_when_ready_ = true;
+    return;
+  }
+
+  // Narrow the dirty region to bytes that differ from panel RAM
+  if (this->diff_updates_ && this->shadow_valid_ && !this->diff_dirty_region_()) {
+    this->frames_skipped_++;
+    ESP_LOGVV(TAG, "Frame unchanged, skipping write");
+    this->clear_dirty_();
+    return;
+  }
+
+  // Capture the window to send; the lambda may keep drawing while it goes out
+  if (this->partial_window_) {
+    // Widen the byte columns to whole column addresses
+    this->flush_row_first_ = this->dirty_row_min_;
+    this->flush_row_last_ = this->dirty_row_max_;
+    this->flush_col_first_ = this->dirty_col_min_ / ST7305_BYTES_PER_COLUMN;
+    this->flush_col_last_ = this->dirty_col_max_ / ST7305_BYTES_PER_COLUMN;
+  } else {
+    this->flush_row_first_ = 0;
+    this->flush_row_last_ = this->row_end_ - this->row_start_;
+    this->flush_col_first_ = 0;
+    this->flush_col_last_ = this->col_end_ - this->col_start_;
+  }
+
+  // Double buffering: bring the front buffer up to date with the rendered frame.
+  // Only the flush window is sent, so this is much cheaper than a full copy.
+  // Async flush implies a partial window, so the flush columns are set here.
+  if (this->front_buffer_ != nullptr) {
+    const uint16_t col_first = this->flush_col_first_ * ST7305_BYTES_PER_COLUMN;
+    const uint16_t length = (this->flush_col_last_ + 1) * ST7305_BYTES_PER_COLUMN - col_first;
+    for (uint16_t row = this->flush_row_first_; row <= this->flush_row_last_; row++) {
+      const uint32_t offset = static_cast<uint32_t>(row) * this->block_stride_ + col_first;
+      memcpy(this->front_buffer_ + offset, this->buffer_ + offset, length);
+    }
+    this->flush_buffer_ = this->front_buffer_;
+  } else {
+    this->flush_buffer_ = this->buffer_;
+  }
+  this->clear_dirty_();
+  this->frame_write_cycles_ = 0;
+
+  this->prepare_power_for_write_();
+
+  if (this->async_flush_) {
+    // Stream the window in row chunks from loop()
+    this->flush_row_next_ = this->flush_row_first_;
+    this->flushing_ = true;
+    this->high_freq_.start();
+    return;
+  }
+
+  this->write_window_(this->flush_row_first_, this->flush_row_last_, this->flush_col_first_, this->flush_col_last_);
+  this->finish_write_();
+}
+
+std::vector<ST7305RLCD *> ST7305RLCD::flush_peers_;
+size_t ST7305RLCD::flush_turn_ = 0;
+
+void ST7305RLCD::loop() {
+  // Several async panels: the first one drives the shared scheduler for all of them
+  const bool shared = flush_peers_.size() > 1;
+  if (shared && flush_peers_.front() == this)
+    run_flush_scheduler_();
+
+  // Reset, init or sleep-out timing pending, the panel can't take commands yet
+  if (!this->ready_)
+    return;
 
-  // Set row address window
-  this->send_command_(0x2B);
-  this->send_data_(this->row_start_);
-  this->send_data_(this->row_end_);
+  if (!shared && this->flushing_ && this->flush_step_())
+    this->flush_done_();
+
+  // Render task finished a frame: send it once the front buffer is free
+  if (this->render_state_.load(std::memory_order_acquire) == ST7305_RENDER_READY && !this->flushing_)
+    this->take_rendered_frame_();
+
+  // Power calls from the lambda on the render task, sent between transfers
+  if (this->deferred_power_.load(std::memory_order_relaxed) != 0 && !this->flushing_)
+    this->apply_deferred_power_();
+
+  // TE pacing: start the transfer right after the panel begins its vertical blank
+  if (this->te_pin_ != nullptr && !this->flushing_ && (this->te_armed_ || this->paced_updates_)) {
+    const uint32_t count = this->te_count_;
+    if (count != this->te_seen_) {
+      // Edges beyond the first went by while the frame was waiting
+      this->missed_vsyncs_ += count - this->te_seen_ - 1;
+      this->te_seen_ = count;
+      this->te_armed_ = false;
+      if (this->paced_updates_ && !this->content_changed_()) {
+        // Paced edges go through the same render skipping as update()
+        this->frames_skipped_++;
+      } else {
+        if (this->paced_updates_)
+          this->render_();
+        this->write_display_();
+      }
+    } else if (this->te_armed_ && millis() - this->te_armed_at_ > ST7305_TE_TIMEOUT_MS) {
+      // No TE edge (panel off or pin not wired), send unsynchronized
+      this->missed_vsyncs_++;
+      this->te_armed_ = false;
+      this->write_display_();
+    }
+    if (!this->flushing_ && !this->te_armed_ && !this->paced_updates_ && this->gray_plane_ == nullptr)
+      this->high_freq_.stop();
+  }
+
+  if (this->power_governor_ && !this->flushing_)
+    this->run_power_governor_();
+
+  // Frame modulation: keep cycling the bitplanes through the panel
+  if (this->gray_plane_ != nullptr && !this->flushing_) {
+    if (this->te_pin_ != nullptr) {
+      // One subframe per panel refresh
+      const uint32_t count = this->te_count_;
+      if (count != this->te_seen_) {
+        this->te_seen_ = count;
+        this->start_subframe_();
+      }
+      return;
+    }
+    const uint32_t now = millis();
+    if (now - this->last_subframe_ >= this->subframe_interval_) {
+      this->last_subframe_ = now;
+      this->start_subframe_();
+    }
+  }
+}
+
+void ST7305RLCD::flush_done_() {
+  if (this->update_pending_) {
+    // An update requested during the flush was held back, run it now. It already
+    // passed the render skipping check, which has taken its change with it.
+    this->update_pending_ = false;
+    this->update_frame_();
+  } else if (this->write_pending_) {
+    // The back buffer was rendered during the flush, send it
+    this->write_pending_ = false;
+    this->queue_write_();
+  }
+}
+
+void ST7305RLCD::run_flush_scheduler_() {
+  // One chunk per loop() pass across all panels, round robin, so the bus time per pass
+  // stays that of a single panel and every queued frame makes progress
+  const size_t count = flush_peers_.size();
+  for (size_t i = 0; i < count; i++) {
+    const size_t index = (flush_turn_ + i) % count;
+    ST7305RLCD *peer = flush_peers_[index];
+    if (!peer->flushing_ || !peer->ready_)
+      continue;
+    flush_turn_ = (index + 1) % count;
+    if (peer->flush_step_())
+      peer->flush_done_();
+    return;
+  }
+}
+
+bool ST7305RLCD::flush_step_() {
+  const uint16_t chunk_last = std::min<uint16_t>(this->flush_row_next_ + this->flush_chunk_rows_ - 1,
+                                                 this->flush_row_last_);
+  this->write_window_(this->flush_row_next_, chunk_last, this->flush_col_first_, this->flush_col_last_);
+  if (chunk_last < this->flush_row_last_) {
+    this->flush_row_next_ = chunk_last + 1;
+    return false;
+  }
+
+  this->flushing_ = false;
+  // Frame modulation and TE pacing poll every pass, keep the fast loop
+  if (this->gray_plane_ == nullptr && !this->te_armed_ && !this->paced_updates_)
+    this->high_freq_.stop();
+  this->finish_write_();
+  return true;
+}
+
+void ST7305RLCD::start_subframe_() {
+  // Subframes show MSB, MSB, LSB: a pixel is black in (2 * msb + lsb) of 3 subframes
+  this->flush_buffer_ = this->subframe_ == 2 ? this->gray_plane_ : this->buffer_;
+  this->subframe_ = (this->subframe_ + 1) % 3;
+  this->clear_dirty_();
+  this->frame_write_cycles_ = 0;
+
+  this->flush_row_first_ = 0;
+  this->flush_row_next_ = 0;
+  this->flush_row_last_ = this->panel_rows_ - 1;
+  this->flush_col_first_ = 0;
+  this->flush_col_last_ = this->col_end_ - this->col_start_;
+  this->flushing_ = true;
+  this->high_freq_.start();
+}
+
+void ST7305RLCD::finish_write_() {
+  this->write_cycles_ = this->frame_write_cycles_;
+
+  if (this->te_pin_ != nullptr && this->te_count_ != this->te_seen_) {
+    // The panel started another refresh before the transfer was done
+    this->missed_vsyncs_++;
+    this->te_seen_ = this->te_count_;
+  }
+
+  if (!this->diff_updates_)
+    return;
+
+  // Panel RAM now matches the flushed window; without partial windows the whole buffer went out
+  if (this->partial_window_ && this->shadow_valid_) {
+    const uint16_t col_first = this->flush_col_first_ * ST7305_BYTES_PER_COLUMN;
+    const uint16_t length = (this->flush_col_last_ + 1) * ST7305_BYTES_PER_COLUMN - col_first;
+    for (uint16_t row = this->flush_row_first_; row <= this->flush_row_last_; row++) {
+      const uint32_t offset = static_cast<uint32_t>(row) * this->block_stride_ + col_first;
+      memcpy(this->shadow_buffer_ + offset, this->flush_buffer_ + offset, length);
+    }
+  } else {
+    memcpy(this->shadow_buffer_, this->flush_buffer_, this->buffer_size_);
+    this->shadow_valid_ = true;
+  }
+}
+
+bool ST7305RLCD::diff_dirty_region_() {
+  // Shrink the dirty box to the bytes that really differ from the shadow copy.
+  // Returns false when the dirty region is identical to what the panel shows.
+  uint16_t row_min = 0xFFFF, row_max = 0, col_min = 0xFFFF, col_max = 0;
+  const uint16_t length = this->dirty_col_max_ + 1 - this->dirty_col_min_;
+
+  for (uint16_t row = this->dirty_row_min_; row <= this->dirty_row_max_; row++) {
+    const uint32_t offset = static_cast<uint32_t>(row) * this->block_stride_ + this->dirty_col_min_;
+    const uint8_t *cur = this->buffer_ + offset;
+    const uint8_t *old = this->shadow_buffer_ + offset;
+    this->bytes_compared_ += length;
+    if (memcmp(cur, old, length) == 0)
+      continue;
+
+    // Scan in from both ends to find the changed byte span of this row
+    uint16_t first = 0;
+    while (cur[first] == old[first])
+      first++;
+    uint16_t last = length - 1;
+    while (cur[last] == old[last])
+      last--;
+
+    if (row < row_min)
+      row_min = row;
+    row_max = row;
+    if (this->dirty_col_min_ + first < col_min)
+      col_min = this->dirty_col_min_ + first;
+    if (this->dirty_col_min_ + last > col_max)
+      col_max = this->dirty_col_min_ + last;
+  }
+
+  if (row_min > row_max)
+    return false;
+
+  this->dirty_row_min_ = row_min;
+  this->dirty_row_max_ = row_max;
+  this->dirty_col_min_ = col_min;
+  this->dirty_col_max_ = col_max;
+  return true;
+}
+
+void ST7305RLCD::write_window_(uint16_t row_first, uint16_t row_last, uint16_t col_first, uint16_t col_last) {
+  const uint32_t start = arch_get_cpu_cycle_count();
+
+  // Set column and row address window
+  const uint8_t cols[] = {static_cast<uint8_t>(this->col_start_ + col_first),
+                          static_cast<uint8_t>(this->col_start_ + col_last)};
+  this->send_command_(0x2A, cols, sizeof(cols));
+  const uint8_t rows[] = {static_cast<uint8_t>(this->row_start_ + row_first),
+                          static_cast<uint8_t>(this->row_start_ + row_last)};
+  this->send_command_(0x2B, rows, sizeof(rows));
 
   // Memory Write - CS must stay LOW for command + all data bytes
   this->dc_pin_->digital_write(false);  // Command mode
@@ -453,26 +1845,52 @@ void ST7305RLCD::write_display_() {
   this->write_byte(0x2C);               // Memory Write command
 
   this->dc_pin_->digital_write(true);   // Data mode (CS still LOW)
-  this->write_array(this->buffer_, this->buffer_size_);
+  if (!this->partial_window_) {
+    this->write_array(this->flush_buffer_, this->buffer_size_);
+    this->bytes_sent_ += this->buffer_size_;
+  } else if (col_first == 0 && (col_last + 1) * ST7305_BYTES_PER_COLUMN == this->block_stride_) {
+    // Full-width rows are contiguous in the buffer
+    const uint32_t offset = static_cast<uint32_t>(row_first - this->strip_base_) * this->block_stride_;
+    this->write_array(this->flush_buffer_ + offset, (row_last - row_first + 1) * this->block_stride_);
+    this->bytes_sent_ += (row_last - row_first + 1) * this->block_stride_;
+  } else {
+    // The controller advances to the next window row after col_last, stream each row segment
+    const uint16_t length = (col_last - col_first + 1) * ST7305_BYTES_PER_COLUMN;
+    for (uint16_t row = row_first; row <= row_last; row++) {
+      const uint32_t offset =
+          static_cast<uint32_t>(row - this->strip_base_) * this->block_stride_ + col_first * ST7305_BYTES_PER_COLUMN;
+      this->write_array(this->flush_buffer_ + offset, length);
+    }
+    this->bytes_sent_ += static_cast<uint32_t>(length) * (row_last - row_first + 1);
+  }
   this->disable();                       // CS HIGH
+
+  this->frame_write_cycles_ += arch_get_cpu_cycle_count() - start;
 }
 
 // =============================================================================
 // SPI Helpers
 // =============================================================================
 
-void ST7305RLCD::send_command_(uint8_t cmd) {
+void ST7305RLCD::send_command_(uint8_t cmd, const uint8_t *data, size_t len) {
+  // Command and parameters in one CS assertion with a single DC transition
   this->dc_pin_->digital_write(false);
   this->enable();
   this->write_byte(cmd);
+  if (len > 0) {
+    this->dc_pin_->digital_write(true);
+    this->write_array(data, len);
+  }
   this->disable();
 }
 
-void ST7305RLCD::send_data_(uint8_t data) {
-  this->dc_pin_->digital_write(true);
-  this->enable();
-  this->write_byte(data);
-  this->disable();
+void ST7305RLCD::send_init_sequence_(const uint8_t *sequence) {
+  while (*sequence != 0x00) {
+    const uint8_t cmd = *sequence++;
+    const uint8_t len = *sequence++;
+    this->send_command_(cmd, sequence, len);
+    sequence += len;
+  }
 }
 
 // =============================================================================
@@ -480,38 +1898,371 @@ void ST7305RLCD::send_data_(uint8_t data) {
 // =============================================================================
 
 void ST7305RLCD::sleep() {
+  if (this->defer_power_(ST7305_DEFER_SLEEP, ST7305_DEFER_WAKE))
+    return;
+  // Sleep In waits for the init sequence or the 120ms after Sleep Out, panel_ready_() sends it
+  if (!this->ready_) {
+    this->sleep_when_ready_ = true;
+    return;
+  }
   this->send_command_(0x10);  // Sleep In
+  this->sleeping_ = true;
   ESP_LOGD(TAG, "Entered sleep mode");
 }
 
 void ST7305RLCD::wake() {
+  if (this->defer_power_(ST7305_DEFER_WAKE, ST7305_DEFER_SLEEP))
+    return;
+  this->sleep_when_ready_ = false;
+  if (!this->ready_)
+    return;
   this->send_command_(0x11);  // Sleep Out
+  this->sleeping_ = false;
   // Per ST7305 datasheet: 120ms delay required after sleep out before sending commands.
-  // This is acceptable because wake() is only called explicitly by user from lambda,
-  // not from loop() or update().
-  delay(120);
-  ESP_LOGD(TAG, "Exited sleep mode");
+  // Writes in the meantime are held back and sent once it has passed.
+  this->ready_ = false;
+  this->set_timeout("wake", 120, [this]() {
+    ESP_LOGD(TAG, "Exited sleep mode");
+    this->panel_ready_();
+  });
 }
 
 void ST7305RLCD::low_power_mode() {
+  if (this->defer_power_(ST7305_DEFER_LOW_POWER, ST7305_DEFER_HIGH_POWER))
+    return;
   this->send_command_(0x39);  // Low Power Mode
+  this->low_power_ = true;
   ESP_LOGD(TAG, "Switched to low power mode");
 }
 
 void ST7305RLCD::high_power_mode() {
+  if (this->defer_power_(ST7305_DEFER_HIGH_POWER, ST7305_DEFER_LOW_POWER))
+    return;
   this->send_command_(0x38);  // High Power Mode
+  this->low_power_ = false;
   ESP_LOGD(TAG, "Switched to high power mode");
 }
 
 void ST7305RLCD::display_on() {
+  if (this->defer_power_(ST7305_DEFER_DISPLAY_ON, ST7305_DEFER_DISPLAY_OFF))
+    return;
   this->send_command_(0x29);  // Display On
+  this->display_off_ = false;
   ESP_LOGD(TAG, "Display on");
 }
 
 void ST7305RLCD::display_off() {
+  if (this->defer_power_(ST7305_DEFER_DISPLAY_OFF, ST7305_DEFER_DISPLAY_ON))
+    return;
   this->send_command_(0x28);  // Display Off
+  this->display_off_ = true;
   ESP_LOGD(TAG, "Display off");
 }
 
+bool ST7305RLCD::defer_power_(uint8_t request, uint8_t opposite) {
+  // SPI belongs to the loop task, a command from the render task would interleave with a flush
+  if (!this->on_render_task_())
+    return false;
+  this->deferred_power_.fetch_and(static_cast<uint8_t>(~opposite), std::memory_order_relaxed);
+  this->deferred_power_.fetch_or(request, std::memory_order_relaxed);
+  return true;
+}
+
+void ST7305RLCD::apply_deferred_power_() {
+  const uint8_t requests = this->deferred_power_.exchange(0, std::memory_order_relaxed);
+  if (requests & ST7305_DEFER_DISPLAY_ON)
+    this->display_on();
+  if (requests & ST7305_DEFER_DISPLAY_OFF)
+    this->display_off();
+  if (requests & ST7305_DEFER_LOW_POWER)
+    this->low_power_mode();
+  if (requests & ST7305_DEFER_HIGH_POWER)
+    this->high_power_mode();
+  // Last: sleep-out holds off further commands for 120ms
+  if (requests & ST7305_DEFER_SLEEP)
+    this->sleep();
+  if (requests & ST7305_DEFER_WAKE)
+    this->wake();
+}
+
+void ST7305RLCD::prepare_power_for_write_() {
+  // The power mode is left as it is, so 1Hz low power refresh survives writes
+  if (this->display_off_)
+    this->display_on();
+  if (!this->power_governor_)
+    return;
+
+  // A frame inside the idle window means content is changing, refresh at full rate
+  const uint32_t now = millis();
+  if (this->low_power_ && now - this->last_write_ < this->low_power_after_)
+    this->high_power_mode();
+  this->last_write_ = now;
+}
+
+void ST7305RLCD::run_power_governor_() {
+  const uint32_t idle = millis() - this->last_write_;
+  if (!this->low_power_ && !this->sleeping_ && idle >= this->low_power_after_) {
+    this->low_power_mode();
+  } else if (this->sleep_after_ != 0 && !this->sleeping_ && idle >= this->sleep_after_) {
+    this->sleep();
+  }
+}
+
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+// PackBits-style runs: control byte c < 0x80 copies c + 1 literal bytes,
+// c >= 0x80 repeats the next byte (c & 0x7F) + 2 times. Mostly white frames
+// collapse to a few bytes per 129-byte run.
+static size_t rle_encode(const uint8_t *src, size_t length, uint8_t *dst, size_t capacity) {
+  size_t in = 0, out = 0;
+  while (in < length) {
+    size_t run = 1;
+    while (in + run < length && run < 129 && src[in + run] == src[in])
+      run++;
+    if (run >= 2) {
+      if (out + 2 > capacity)
+        return 0;
+      dst[out++] = 0x80 | (run - 2);
+      dst[out++] = src[in];
+      in += run;
+      continue;
+    }
+    // Literal stretch up to the next run of two
+    size_t literal = 1;
+    while (in + literal < length && literal < 128 &&
+           !(in + literal + 1 < length && src[in + literal] == src[in + literal + 1]))
+      literal++;
+    if (out + 1 + literal > capacity)
+      return 0;
+    dst[out++] = literal - 1;
+    memcpy(dst + out, src + in, literal);
+    out += literal;
+    in += literal;
+  }
+  return out;
+}
+
+static bool rle_decode(const uint8_t *src, size_t length, uint8_t *dst, size_t expected) {
+  size_t in = 0, out = 0;
+  while (in < length) {
+    const uint8_t control = src[in++];
+    if (control & 0x80) {
+      const size_t run = (control & 0x7F) + 2;
+      if (in >= length || out + run > expected)
+        return false;
+      memset(dst + out, src[in++], run);
+      out += run;
+    } else {
+      const size_t literal = control + 1;
+      if (in + literal > length || out + literal > expected)
+        return false;
+      memcpy(dst + out, src + in, literal);
+      in += literal;
+      out += literal;
+    }
+  }
+  return out == expected;
+}
+
+uint32_t ST7305RLCD::snapshot_geometry_() const {
+  return (static_cast<uint32_t>(this->width_) << 11) | (static_cast<uint32_t>(this->height_) << 1) |
+         (this->orientation_ == ST7305_ORIENTATION_PORTRAIT ? 1 : 0);
+}
+
+bool ST7305RLCD::save_snapshot() {
+  if (this->buffer_ == nullptr || this->strip_rows_ != 0)
+    return false;
+  const size_t length = rle_encode(this->buffer_, this->buffer_size_, st7305_snapshot.data, sizeof(st7305_snapshot.data));
+  if (length == 0) {
+    st7305_snapshot.magic = 0;
+    ESP_LOGW(TAG, "Frame doesn't compress into %u bytes, no snapshot", (unsigned) sizeof(st7305_snapshot.data));
+    return false;
+  }
+  st7305_snapshot.geometry = this->snapshot_geometry_();
+  st7305_snapshot.length = length;
+  st7305_snapshot.crc = crc16(st7305_snapshot.data, length);
+  st7305_snapshot.content_hash = this->last_content_hash_;
+  st7305_snapshot.magic = ST7305_SNAPSHOT_MAGIC;
+  ESP_LOGD(TAG, "Snapshot saved: %zu -> %zu bytes", this->buffer_size_, length);
+  return true;
+}
+
+bool ST7305RLCD::restore_snapshot() {
+  if (this->buffer_ == nullptr || this->strip_rows_ != 0)
+    return false;
+  if (st7305_snapshot.magic != ST7305_SNAPSHOT_MAGIC || st7305_snapshot.geometry != this->snapshot_geometry_() ||
+      st7305_snapshot.length > sizeof(st7305_snapshot.data) ||
+      st7305_snapshot.crc != crc16(st7305_snapshot.data, st7305_snapshot.length))
+    return false;
+  if (!rle_decode(st7305_snapshot.data, st7305_snapshot.length, this->buffer_, this->buffer_size_)) {
+    memset(this->buffer_, 0xFF, this->buffer_size_);
+    return false;
+  }
+  this->mark_dirty_all_();
+  ESP_LOGD(TAG, "Snapshot restored (%u bytes)", (unsigned) st7305_snapshot.length);
+  return true;
+}
+
+void ST7305RLCD::clear_snapshot() { st7305_snapshot.magic = 0; }
+
+void ST7305RLCD::on_shutdown() {
+  // Deep sleep runs the shutdown hooks, keep the last frame for the next boot
+  bool saved = false;
+  if (this->snapshot_)
+    saved = this->save_snapshot();
+
+  st7305_panel_state.magic = 0;
+  // Mid-reset or mid-wake the panel state is unknown, the next boot starts from scratch
+  if (!this->resume_ || !this->ready_)
+    return;
+  st7305_panel_state.geometry = this->snapshot_geometry_();
+  st7305_panel_state.sleeping = this->sleeping_;
+  st7305_panel_state.low_power = this->low_power_;
+  st7305_panel_state.display_off = this->display_off_;
+  st7305_panel_state.in_sync = saved && !this->flushing_ && !this->is_dirty_() && this->gray_plane_ == nullptr;
+  st7305_panel_state.magic = ST7305_PANEL_STATE_MAGIC;
+}
+
+// =============================================================================
+// Framebuffer Dump
+// =============================================================================
+
+void ST7305RLCD::dump_framebuffer() {
+  if (this->buffer_ == nullptr)
+    return;
+  if (this->strip_rows_ != 0) {
+    ESP_LOGW(TAG, "Strip mode keeps no full framebuffer to dump");
+    return;
+  }
+
+  // Header carries everything tools/st7305_decode.py needs to unpack the blocks
+  ESP_LOGI(TAG, "FB %s %u %u %u %u", this->orientation_ == ST7305_ORIENTATION_PORTRAIT ? "P" : "L", this->width_,
+           this->height_, this->block_stride_, this->buffer_rows_);
+  static const size_t LINE_BYTES = 64;
+  char line[LINE_BYTES * 2 + 1];
+  for (size_t offset = 0; offset < this->buffer_size_; offset += LINE_BYTES) {
+    const size_t length = std::min(LINE_BYTES, this->buffer_size_ - offset);
+    for (size_t i = 0; i < length; i++)
+      snprintf(line + i * 2, 3, "%02X", this->buffer_[offset + i]);
+    ESP_LOGI(TAG, "FB %05u %s", static_cast<unsigned>(offset), line);
+    if ((offset / LINE_BYTES) % 32 == 31)
+      App.feed_wdt();
+  }
+  ESP_LOGI(TAG, "FB END");
+}
+
+// =============================================================================
+// Benchmark
+// =============================================================================
+
+void ST7305RLCD::log_benchmark_(const char *name, uint32_t ops, uint32_t elapsed_us) {
+  if (elapsed_us == 0)
+    elapsed_us = 1;
+  ESP_LOGI(TAG, "  %-16s %6" PRIu32 " ops %9.1f us/op %10.0f ops/s", name, ops, static_cast<float>(elapsed_us) / ops,
+           ops * 1e6f / elapsed_us);
+  App.feed_wdt();
+}
+
+void ST7305RLCD::run_benchmark() {
+  if (this->buffer_ == nullptr || !this->ready_ || this->flushing_ || this->strip_rows_ != 0) {
+    ESP_LOGW(TAG, "Benchmark needs an idle, initialized panel with a full framebuffer");
+    return;
+  }
+
+  const int width = this->get_width();
+  const int height = this->get_height();
+  ESP_LOGI(TAG, "Benchmark (%dx%d, %" PRIu32 " Hz SPI, rotation %d):", width, height, this->data_rate_,
+           static_cast<int>(this->rotation_));
+
+  // Transfers are timed synchronously and in full; async flush and TE pacing would only
+  // measure queueing, diffing would skip the repeated frames
+  const bool async_flush = this->async_flush_;
+  this->async_flush_ = false;
+  const bool diff_updates = this->diff_updates_;
+  this->diff_updates_ = false;
+  InternalGPIOPin *te_pin = this->te_pin_;
+  this->te_pin_ = nullptr;
+  uint32_t start;
+
+  start = micros();
+  for (int i = 0; i < 50; i++)
+    this->fill((i & 1) ? COLOR_ON : COLOR_OFF);
+  this->log_benchmark_("fill", 50, micros() - start);
+
+  start = micros();
+  for (int i = 0; i < 10000; i++) {
+    const uint32_t r = random_uint32();
+    this->draw_pixel_at((r & 0xFFFF) % width, (r >> 16) % height, (r & 0x100) ? COLOR_ON : COLOR_OFF);
+  }
+  this->log_benchmark_("random pixel", 10000, micros() - start);
+
+  start = micros();
+  for (int y = 0; y < height; y++)
+    this->fill_hline(0, y, width, (y & 1) ? COLOR_ON : COLOR_OFF);
+  this->log_benchmark_("fill_hline", height, micros() - start);
+
+  start = micros();
+  for (int x = 0; x < width; x++)
+    this->fill_vline(x, 0, height, (x & 1) ? COLOR_ON : COLOR_OFF);
+  this->log_benchmark_("fill_vline", width, micros() - start);
+
+  // Generic Display path for comparison, one draw_pixel_at() per pixel
+  start = micros();
+  for (int y = 0; y < height; y++)
+    this->horizontal_line(0, y, width, (y & 1) ? COLOR_ON : COLOR_OFF);
+  this->log_benchmark_("horizontal_line", height, micros() - start);
+
+  // Text-like load: 8x16 glyph cells of nested rectangles across the screen
+  start = micros();
+  uint32_t cells = 0;
+  for (int y = 0; y + 16 <= height; y += 16) {
+    for (int x = 0; x + 8 <= width; x += 8) {
+      this->fill_rect(x + 1, y + 2, 6, 12, COLOR_ON);
+      this->fill_rect(x + 2, y + 4, 4, 8, COLOR_OFF);
+      cells++;
+    }
+  }
+  this->log_benchmark_("glyph cells", cells, micros() - start);
+
+  // 64x64 checkerboard bitmap, opaque
+  static const uint8_t CHECKER[2] = {0xCC, 0x33};
+  uint8_t bitmap[64 * 64 / 8];
+  for (size_t i = 0; i < sizeof(bitmap); i++)
+    bitmap[i] = CHECKER[(i / 8 / 2) & 1];
+  start = micros();
+  for (int i = 0; i < 50; i++)
+    this->draw_bitmap((i * 37) % std::max(1, width - 64), (i * 23) % std::max(1, height - 64), 64, 64, bitmap,
+                      COLOR_ON, COLOR_OFF, false);
+  this->log_benchmark_("bitmap 64x64", 50, micros() - start);
+
+  start = micros();
+  for (int i = 0; i < 5; i++) {
+    this->mark_dirty_all_();
+    this->write_display_();
+  }
+  this->log_benchmark_("full flush", 5, micros() - start);
+
+  if (this->partial_window_) {
+    start = micros();
+    for (int i = 0; i < 20; i++) {
+      this->fill_rect((i * 37) % std::max(1, width - 40), (i * 23) % std::max(1, height - 40), 40, 40,
+                      (i & 1) ? COLOR_ON : COLOR_OFF);
+      this->write_display_();
+    }
+    this->log_benchmark_("partial 40x40", 20, micros() - start);
+  }
+
+  this->async_flush_ = async_flush;
+  this->te_pin_ = te_pin;
+  this->diff_updates_ = diff_updates;
+  this->shadow_valid_ = false;  // Not tracked during the benchmark
+  this->background_valid_ = false;
+  ESP_LOGI(TAG, "Benchmark done, redrawing");
+  this->fill(COLOR_OFF);
+  this->update();
+}
+
 }  // namespace st7305_rlcd
 }  // namespace esphome
@@ -16,25 +16,111 @@
 
 #pragma once
 
+#include <atomic>
+#include <vector>
+
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "st7305_panels.h"
+
+#ifdef USE_IMAGE
+#include "esphome/components/image/image.h"
+#endif
+
+#ifdef USE_FONT
+#include "esphome/components/font/font.h"
+#endif
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// Hot pixel and span paths in IRAM, avoiding flash cache misses (iram_hot_path option)
+#ifdef ST7305_IRAM_HOT_PATH
+#define ST7305_HOT IRAM_ATTR
+#else
+#define ST7305_HOT
+#endif
 
 namespace esphome {
 namespace st7305_rlcd {
 
-/// Panel model enumeration
-enum ST7305Model : uint8_t {
-  ST7305_MODEL_WAVESHARE_400X300 = 0,  ///< Landscape 2×4 blocks
-  ST7305_MODEL_OSPTEK_200X200,         ///< Square 4×2 blocks
-  ST7305_MODEL_CUSTOM,                 ///< User-defined
+/// Buffer bytes covered by one column address of the 0x2A window (12 pixels)
+static const uint8_t ST7305_BYTES_PER_COLUMN = 3;
+
+/// Longest wait for a TE edge before a queued frame is sent unsynchronized (low power mode is ~1Hz)
+static const uint32_t ST7305_TE_TIMEOUT_MS = 1100;
+/// Data rate the panel is known to work at, used when verification of a faster rate fails
+static const uint32_t ST7305_SAFE_DATA_RATE = spi::DATA_RATE_10MHZ;
+
+/// Stack of the render task; the lambda's text and image drawing runs on it
+#ifndef ST7305_RENDER_TASK_STACK
+#define ST7305_RENDER_TASK_STACK 8192
+#endif
+
+/// Packed snapshot space in RTC memory; ESPHome's RTC_NOINIT area on ESP32 is 8KB in total
+#ifndef ST7305_SNAPSHOT_CAPACITY
+#define ST7305_SNAPSHOT_CAPACITY 4096
+#endif
+
+/// Where the framebuffers are allocated
+enum ST7305BufferMemory : uint8_t {
+  ST7305_BUFFER_MEMORY_AUTO,      ///< Framebuffer in internal RAM when it fits (pixel RMW is latency bound), rest PSRAM
+  ST7305_BUFFER_MEMORY_INTERNAL,  ///< Internal RAM, PSRAM only if internal allocation fails
+  ST7305_BUFFER_MEMORY_EXTERNAL,  ///< PSRAM first (previous behaviour)
+};
+
+/// Largest framebuffer AUTO places in internal RAM
+static const size_t ST7305_AUTO_INTERNAL_MAX = 32 * 1024;
+/// draw_pixel_at() feeds the watchdog once per this many calls (power of two)
+static const uint32_t ST7305_WDT_PIXELS = 1024;
+
+/// Conversion of gray levels to 1-bit pixels
+enum ST7305DitherMode : uint8_t {
+  ST7305_DITHER_NONE = 0,         ///< Fixed 50% threshold
+  ST7305_DITHER_BAYER,            ///< 4×4 ordered dither, evaluated per block byte
+  ST7305_DITHER_FLOYD_STEINBERG,  ///< Error diffusion in source order (draw_grayscale() only)
 };
 
-/// Pixel block orientation (determines LUT calculation)
-enum ST7305Orientation : uint8_t {
-  ST7305_ORIENTATION_LANDSCAPE = 0,  ///< 2 cols × 4 rows per byte
-  ST7305_ORIENTATION_PORTRAIT,       ///< 4 cols × 2 rows per byte
+/// How combine_layer() merges a layer into the framebuffer, in terms of black pixels
+enum ST7305RasterOp : uint8_t {
+  ST7305_ROP_COPY = 0,  ///< Take the layer's pixels
+  ST7305_ROP_AND,       ///< Black where both are black
+  ST7305_ROP_OR,        ///< Black where either is black
+  ST7305_ROP_XOR,       ///< Black where exactly one is black
+};
+
+/// Ownership of the back buffer with render_task: loop -> task (RENDERING) -> loop (READY)
+enum ST7305RenderState : uint8_t {
+  ST7305_RENDER_IDLE = 0,
+  ST7305_RENDER_RENDERING,
+  ST7305_RENDER_READY,
+};
+
+/// Power calls made on the render task, applied by loop() between transfers
+enum ST7305DeferredPower : uint8_t {
+  ST7305_DEFER_SLEEP = 1 << 0,
+  ST7305_DEFER_WAKE = 1 << 1,
+  ST7305_DEFER_LOW_POWER = 1 << 2,
+  ST7305_DEFER_HIGH_POWER = 1 << 3,
+  ST7305_DEFER_DISPLAY_ON = 1 << 4,
+  ST7305_DEFER_DISPLAY_OFF = 1 << 5,
+};
+
+/// 4×4 Bayer thresholds (0-255), indexed by [y & 3][x & 3] of the absolute pixel
+static const uint8_t ST7305_BAYER_4X4[4][4] = {
+    {8, 136, 40, 168},
+    {200, 72, 232, 104},
+    {56, 184, 24, 152},
+    {248, 120, 216, 88},
 };
 
 class ST7305RLCD : public display::DisplayBuffer,
@@ -42,22 +128,134 @@ class ST7305RLCD : public display::DisplayBuffer,
                                          spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_10MHZ> {
  public:
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
+  void on_shutdown() override;
   void fill(Color color) override;
+  /// Clipping, rotation and block addressing in one specialized step (replaces DisplayBuffer's translation)
+  void draw_pixel_at(int x, int y, Color color) override;
 
   // Configuration setters (called from Python codegen)
   void set_dc_pin(GPIOPin *pin) { this->dc_pin_ = pin; }
   void set_reset_pin(GPIOPin *pin) { this->reset_pin_ = pin; }
+  void set_te_pin(InternalGPIOPin *pin) { this->te_pin_ = pin; }
   void set_model(ST7305Model model) { this->model_ = model; }
+  /// Apply a predefined panel profile (geometry, window, gate lines, voltages, timing)
+  void set_profile(const ST7305PanelProfile &profile);
+  // CUSTOM panel fields
   void set_width(uint16_t width) { this->width_ = width; }
   void set_height(uint16_t height) { this->height_ = height; }
   void set_orientation(ST7305Orientation orientation) { this->orientation_ = orientation; }
+  void set_col_start(uint8_t col) { this->col_start_ = col; }
+  void set_col_end(uint8_t col) { this->col_end_ = col; }
+  void set_row_start(uint8_t row) { this->row_start_ = row; }
+  void set_row_end(uint8_t row) { this->row_end_ = row; }
+  void set_gate_lines(uint8_t gate_lines) { this->gate_lines_ = gate_lines; }
+  void set_voltages(uint8_t vshp, uint8_t vslp, uint8_t vshn, uint8_t vsln) {
+    this->vshp_ = vshp;
+    this->vslp_ = vslp;
+    this->vshn_ = vshn;
+    this->vsln_ = vsln;
+  }
+  void set_dither(ST7305DitherMode dither) { this->dither_ = dither; }
+  void set_buffer_memory(ST7305BufferMemory memory) { this->buffer_memory_ = memory; }
+  /// Strip mode: hold only this many panel RAM rows and run the lambda once per strip (0 = full buffer)
+  void set_strip_rows(uint16_t rows) { this->strip_rows_ = rows; }
+  void set_verify_data_rate(bool verify) { this->verify_data_rate_ = verify; }
+  void set_diff_updates(bool diff_updates) { this->diff_updates_ = diff_updates; }
+  void set_async_flush(bool async_flush) { this->async_flush_ = async_flush; }
+  void set_flush_chunk_rows(uint16_t rows) { this->flush_chunk_rows_ = rows; }
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
+  void set_frame_modulation(bool frame_modulation) { this->frame_modulation_ = frame_modulation; }
+  void set_subframe_interval(uint32_t interval) { this->subframe_interval_ = interval; }
+  void set_paced_updates(bool paced_updates) { this->paced_updates_ = paced_updates; }
+  /**
+   * @brief Skip ticks whose lambda inputs haven't changed
+   *
+   * With a content hash and/or watched entities, update() first checks
+   * whether anything the lambda shows changed. If not, it neither runs the
+   * lambda nor writes. Without either, every tick renders as before.
+   */
+  void set_content_hash(std::function<uint32_t()> &&hash) { this->content_hash_ = hash; }
+  /// Render on the next tick after entity publishes a new state (sensor, binary or text sensor, ...)
+  template<typename T> void watch(T *entity) {
+    this->watching_ = true;
+    entity->add_on_state_callback([this](const auto &...) { this->content_dirty_ = true; });
+  }
+  /// Force the next update() to run the lambda
+  void invalidate_content() { this->content_dirty_ = true; }
+  /// Run the lambda in a FreeRTOS task on the other core (ESP32, needs double_buffer); SPI stays on the loop
+  void set_render_task(bool render_task) { this->render_task_enabled_ = render_task; }
+  /// Enable the power governor: low power after low_power_after ms without writes, sleep after
+  /// sleep_after ms (0 = never)
+  void set_power_governor(uint32_t low_power_after, uint32_t sleep_after) {
+    this->power_governor_ = true;
+    this->low_power_after_ = low_power_after;
+    this->sleep_after_ = sleep_after;
+  }
+
+  /// True while a frame is being streamed out by loop(). Without double buffering
+  /// the buffer must not be drawn to.
+  bool is_flushing() const { return this->flushing_; }
+
+  /// Bytes compared against the shadow buffer since boot (diff_updates only)
+  uint32_t get_bytes_compared() const { return this->bytes_compared_; }
+  /// Pixel data bytes sent to the panel since boot
+  uint32_t get_bytes_sent() const { return this->bytes_sent_; }
+  /// Writes skipped because the frame matched what the panel already shows
+  uint32_t get_frames_skipped() const { return this->frames_skipped_; }
+  /// Panel refreshes a frame missed: waited past more than one TE edge, overran into the next one, or timed out
+  uint32_t get_missed_vsyncs() const { return this->missed_vsyncs_; }
+  /// draw_pixel_at() calls since boot (the block fast paths don't count)
+  uint32_t get_pixel_calls() const { return this->pixel_calls_; }
+  /// Duration of the last do_update_() (the display lambda)
+  uint32_t get_render_time_us() const { return this->render_cycles_ / (arch_get_cpu_freq_hz() / 1000000); }
+  /// SPI time of the last completed frame, summed over all async chunks
+  uint32_t get_write_time_us() const { return this->write_cycles_ / (arch_get_cpu_freq_hz() / 1000000); }
+
+  /// Keep the framebuffer in RTC memory on shutdown and restore it at boot
+  void set_snapshot(bool snapshot) { this->snapshot_ = snapshot; }
+  /// Take over a panel that stayed powered through deep sleep instead of resetting it
+  void set_resume(bool resume) { this->resume_ = resume; }
+  /// True if this boot skipped the reset and init sequence
+  bool is_resumed() const { return this->resumed_; }
+  /// RLE-pack the framebuffer into RTC memory; false if it doesn't fit
+  bool save_snapshot();
+  /// Unpack the RTC snapshot into the framebuffer; false if there is none for this panel
+  bool restore_snapshot();
+  void clear_snapshot();
+  /// True from a boot that restored a snapshot until the first update()
+  bool is_snapshot_restored() const { return this->snapshot_restored_; }
+
+  /// Log the framebuffer as hex lines; tools/st7305_decode.py turns the log into a PNG
+  void dump_framebuffer();
+
+  /**
+   * @brief Run the drawing and flush benchmark suite and log the results
+   *
+   * Blocks for a second or two (the watchdog is fed between tests) and
+   * overwrites the framebuffer, which is redrawn by update() afterwards.
+   */
+  void run_benchmark();
+  void set_benchmark_on_boot(bool benchmark) { this->benchmark_on_boot_ = benchmark; }
+
+#ifdef USE_SENSOR
+  void set_render_time_sensor(sensor::Sensor *sensor) { this->render_time_sensor_ = sensor; }
+  void set_write_time_sensor(sensor::Sensor *sensor) { this->write_time_sensor_ = sensor; }
+  void set_bytes_sent_sensor(sensor::Sensor *sensor) { this->bytes_sent_sensor_ = sensor; }
+  void set_frames_skipped_sensor(sensor::Sensor *sensor) { this->frames_skipped_sensor_ = sensor; }
+  void set_pixel_calls_sensor(sensor::Sensor *sensor) { this->pixel_calls_sensor_ = sensor; }
+  /// Publish the instrumentation sensors every interval ms
+  void set_stats_interval(uint32_t interval) { this->stats_interval_ = interval; }
+#endif
 
   /// Enter sleep mode (lowest power, display blanks, RAM retained)
   void sleep();
-  /// Exit sleep mode (120ms delay required by controller)
+  /// Exit sleep mode; returns immediately, frames drawn during the 120ms sleep-out delay are sent after it
   void wake();
+  /// False while the reset, init or sleep-out sequence is still running
+  bool is_ready() const { return this->ready_; }
   /// Switch to low power refresh (~1Hz) for static content
   void low_power_mode();
   /// Switch to high power refresh (~51Hz) for animations
@@ -66,8 +264,128 @@ class ST7305RLCD : public display::DisplayBuffer,
   void display_on();
   /// Turn display off (RAM retained, instant recovery)
   void display_off();
+  bool is_sleeping() const { return this->sleeping_; }
+  bool is_low_power() const { return this->low_power_; }
 
-  display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_BINARY; }
+  /**
+   * @brief Fast filled rectangle in rotated (user) coordinates
+   *
+   * Unlike Display::filled_rectangle(), which draws pixel by pixel, whole
+   * 2×4 / 4×2 blocks are written as bytes (memset along each panel RAM row)
+   * and only edge bytes are masked. Honors rotation and clipping.
+   */
+  void fill_rect(int x, int y, int width, int height, Color color = COLOR_ON);
+  /// Fast horizontal line in user coordinates (see fill_rect())
+  void fill_hline(int x, int y, int width, Color color = COLOR_ON) { this->fill_rect(x, y, width, 1, color); }
+  /// Fast vertical line in user coordinates (see fill_rect())
+  void fill_vline(int x, int y, int height, Color color = COLOR_ON) { this->fill_rect(x, y, 1, height, color); }
+
+  /**
+   * @brief Blit a 1-bpp bitmap in user coordinates
+   *
+   * Source rows are MSB first, (width + 7) / 8 bytes each (the ESPHome binary
+   * image layout). Each destination byte is assembled from the source pixels
+   * of its 2×4 / 4×2 block and written once; rotation is resolved per blit,
+   * not per pixel. Set bits are drawn with color, clear bits with background
+   * unless transparent.
+   */
+  void draw_bitmap(int x, int y, int width, int height, const uint8_t *data, Color color = COLOR_ON,
+                   Color background = COLOR_OFF, bool transparent = true);
+  /**
+   * @brief Draw 8-bit luminance data (0 = black, 255 = white) in user coordinates
+   *
+   * BAYER and NONE are evaluated per destination byte through the block
+   * blitter; FLOYD_STEINBERG diffuses the error in source row order.
+   */
+  void draw_grayscale(int x, int y, int width, int height, const uint8_t *luminance,
+                      ST7305DitherMode mode = ST7305_DITHER_BAYER);
+  /// Limit scroll() to user rows [top, top + height); height 0 = the whole screen
+  void set_scroll_area(int top, int height) {
+    this->scroll_top_ = top;
+    this->scroll_height_ = height;
+  }
+  /**
+   * @brief Shift the scroll area up by lines (down when negative) and fill the exposed lines
+   *
+   * Content is moved inside the framebuffer with memmove when the shift lines
+   * up with whole blocks (2 pixels across panel RAM rows, 4 along them),
+   * otherwise pixel by pixel. The area is marked dirty, so the lambda doesn't
+   * have to redraw the retained lines.
+   */
+  void scroll(int lines, Color fill = COLOR_OFF);
+
+  /**
+   * @brief Raster operations on the packed framebuffer, in user coordinates
+   *
+   * Whole buffer bytes are processed 32 bits at a time and only the bytes on
+   * the rectangle's edges are masked, so inverting a menu row or XOR-ing a
+   * cursor costs a few µs. With frame modulation both bitplanes are updated.
+   */
+  void invert_rect(int x, int y, int width, int height);
+  /// Merge a layer from create_layer() into the framebuffer within a rectangle
+  void combine_layer(const uint8_t *layer, ST7305RasterOp op, int x, int y, int width, int height);
+  void combine_layer(const uint8_t *layer, ST7305RasterOp op) {
+    this->combine_layer(layer, op, 0, 0, this->get_width(), this->get_height());
+  }
+  /// Copy a rectangle to another position; overlapping areas are handled. Moves that keep
+  /// the block alignment copy whole bytes, others go pixel by pixel through the blitter.
+  void copy_rect(int src_x, int src_y, int width, int height, int dst_x, int dst_y);
+  /**
+   * @brief Draw static content once into a retained background plane
+   *
+   * The writer runs on the first update() (and after invalidate_background())
+   * into its own layer. Each update() then puts the background back only
+   * where the previous frame's lambda drew before running the lambda, so the
+   * lambda just draws the changing values and only that area is sent.
+   * Needs auto_clear_enabled: false.
+   */
+  void set_background_writer(display::display_writer_t &&writer) { this->background_writer_ = writer; }
+  /// Redraw the background plane on the next update()
+  void invalidate_background();
+
+  /**
+   * Allocate an all-white 1-bpp layer in the framebuffer's packed layout
+   * (following buffer_memory). Layers are meant to be created once and are
+   * never freed. Returns nullptr on failure and in strip mode.
+   */
+  uint8_t *create_layer();
+  /// Run draw() with every drawing call going to layer instead of the screen
+  template<typename F> void draw_layer(uint8_t *layer, F &&draw) {
+    if (layer == nullptr || this->buffer_ == nullptr)
+      return;
+    uint8_t *screen = this->buffer_, *gray = this->gray_plane_;
+    const uint16_t dirty[] = {this->dirty_row_min_, this->dirty_row_max_, this->dirty_col_min_, this->dirty_col_max_};
+    this->buffer_ = layer;
+    this->gray_plane_ = nullptr;  // Layers are 1-bpp
+    draw();
+    this->buffer_ = screen;
+    this->gray_plane_ = gray;
+    this->dirty_row_min_ = dirty[0], this->dirty_row_max_ = dirty[1];
+    this->dirty_col_min_ = dirty[2], this->dirty_col_max_ = dirty[3];
+  }
+#ifdef USE_IMAGE
+  /// Blit a binary image::Image through draw_bitmap(); other image types use the generic path
+  void draw_image(int x, int y, image::Image *image, Color color = COLOR_ON, Color background = COLOR_OFF);
+#endif
+#ifdef USE_FONT
+  /**
+   * @brief Draw text in user coordinates, aligned like Display::print()
+   *
+   * Glyph bitmaps of 1-bpp fonts go through the block blitter, one blit per
+   * glyph with set bits drawn in color. Anti-aliased fonts (bpp > 1) keep
+   * Font::print() and its per-pixel blending.
+   */
+  void draw_text(int x, int y, font::Font *font, Color color, display::TextAlign align, const char *text);
+  void draw_text(int x, int y, font::Font *font, Color color, const char *text) {
+    this->draw_text(x, y, font, color, display::TextAlign::TOP_LEFT, text);
+  }
+#endif
+
+  display::DisplayType get_display_type() override {
+    return (this->dither_ == ST7305_DITHER_NONE && !this->frame_modulation_)
+               ? display::DisplayType::DISPLAY_TYPE_BINARY
+               : display::DisplayType::DISPLAY_TYPE_GRAYSCALE;
+  }
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
@@ -75,24 +393,189 @@ class ST7305RLCD : public display::DisplayBuffer,
   int get_height_internal() override { return this->height_; }
   size_t get_buffer_length_() { return this->buffer_size_; }
 
+  /**
+   * @brief Compute the panel RAM row, byte column and bit mask for an absolute pixel
+   *
+   * Replaces the former per-pixel lookup tables with shifts and masks,
+   * specialized per block orientation at compile time. The buffer index is
+   * row * block_stride_ + col.
+   *
+   * Landscape (2×4 blocks): rows of the panel RAM hold column pairs, each
+   * byte covers 4 rows counted from the bottom edge.
+   * Portrait (4×2 blocks): rows of the panel RAM hold row pairs, each byte
+   * covers 4 columns.
+   */
+  template<ST7305Orientation O>
+  inline void locate_(int x, int y, uint16_t &row, uint16_t &col, uint8_t &mask) const {
+    if (O == ST7305_ORIENTATION_LANDSCAPE) {
+      const uint16_t inv_y = this->height_ - 1 - y;
+      row = x >> 1;
+      col = inv_y >> 2;
+      mask = 0x80 >> (((inv_y & 3) << 1) | (x & 1));
+    } else {
+      row = y >> 1;
+      col = x >> 2;
+      mask = 0x80 >> (((y & 1) << 2) | (x & 3));
+    }
+  }
+  template<ST7305Orientation O> inline void set_pixel_(int x, int y, bool on) {
+    uint16_t row, col;
+    uint8_t mask;
+    this->locate_<O>(x, y, row, col, mask);
+    // Buffer-relative row; outside the resident strip (strip mode only) the unsigned compare rejects it
+    row -= this->strip_base_;
+    if (row >= this->buffer_rows_)
+      return;
+    uint8_t *byte = &this->buffer_[static_cast<uint32_t>(row) * this->block_stride_ + col];
+    const uint8_t value = on ? (*byte & ~mask) : (*byte | mask);  // Black = bit clear, White = bit set
+    if (value == *byte)
+      return;
+    *byte = value;
+    this->mark_dirty_(row, col);
+  }
+
+  /**
+   * @brief Draw a pixel given in rotated (user) coordinates
+   *
+   * One variant per orientation × rotation × dithering, selected when the
+   * rotation changes. The rotation is folded into the block addressing at
+   * compile time instead of being applied by DisplayBuffer before the pixel
+   * lookup. Dithered variants treat the color's luminance as ink coverage
+   * (COLOR_ON = black) and threshold it against the Bayer matrix.
+   */
+  template<ST7305Orientation O, display::DisplayRotation R, bool D>
+  void ST7305_HOT draw_rotated_pixel_(int x, int y, Color color) {
+    int ax, ay;
+    if (R == display::DISPLAY_ROTATION_90_DEGREES) {
+      ax = this->width_ - 1 - y, ay = x;
+    } else if (R == display::DISPLAY_ROTATION_180_DEGREES) {
+      ax = this->width_ - 1 - x, ay = this->height_ - 1 - y;
+    } else if (R == display::DISPLAY_ROTATION_270_DEGREES) {
+      ax = y, ay = this->height_ - 1 - x;
+    } else {
+      ax = x, ay = y;
+    }
+    if (ax < 0 || ax >= this->width_ || ay < 0 || ay >= this->height_)
+      return;
+    const bool on = D ? color_to_ink_(color) > ST7305_BAYER_4X4[ay & 3][ax & 3] : color.is_on();
+    this->set_pixel_<O>(ax, ay, on);
+  }
+  static uint8_t color_to_ink_(Color color) { return (color.r * 77 + color.g * 150 + color.b * 29) >> 8; }
+  void select_pixel_fn_();
+
+  // Dirty region tracking, in panel RAM rows and byte columns
+  inline void mark_dirty_(uint16_t row, uint16_t col) {
+    if (row < this->dirty_row_min_)
+      this->dirty_row_min_ = row;
+    if (row > this->dirty_row_max_)
+      this->dirty_row_max_ = row;
+    if (col < this->dirty_col_min_)
+      this->dirty_col_min_ = col;
+    if (col > this->dirty_col_max_)
+      this->dirty_col_max_ = col;
+  }
+  /// Clip a user-space rectangle (inclusive corners) and convert it to absolute panel coordinates
+  bool clip_to_absolute_(int &x0, int &y0, int &x1, int &y1);
+  /// Byte mask of the pixels in one block covering major offsets [m0, m1] and minor offsets [n0, n1]
+  uint8_t block_mask_(uint8_t m0, uint8_t m1, uint8_t n0, uint8_t n1) const;
+  /// Move content along one buffer axis: new[p] = old[p + shift] for p in [first, last]
+  void shift_axis_(bool major, int first, int last, int shift);
+  /// Read back a pixel in user coordinates (must be on screen, full framebuffer only)
+  bool is_black_(int x, int y) const;
+  /// Convert an absolute rectangle to pixel ranges along the panel RAM rows (major) and bytes (minor)
+  void absolute_to_axes_(int x0, int y0, int x1, int y1, int &major0, int &major1, int &minor0, int &minor1) const;
+  /// Call op(bytes, count, mask) for every run of buffer bytes covered by an absolute rectangle
+  template<typename F> void for_each_block_run_(int x0, int y0, int x1, int y1, F &&op);
+  /**
+   * Assemble whole buffer bytes from a source of width×height pixels placed at user (x, y).
+   * pixel(sx, sy, ax, ay) returns 1 for black, 0 for white or -1 to leave the pixel untouched.
+   */
+  template<typename F> void blit_blocks_(int x, int y, int width, int height, F &&pixel);
+  void mark_dirty_all_();
+  void clear_dirty_();
+  bool diff_dirty_region_();
+  bool is_dirty_() const { return this->dirty_row_min_ <= this->dirty_row_max_; }
+
+  /// Allocate a framebuffer-sized block following buffer_memory_; primary is the framebuffer drawn into
+  uint8_t *allocate_buffer_(size_t size, bool primary = false);
   void apply_model_settings_();
   void hardware_reset_();
+  void verify_data_rate_setup_();
+  bool read_display_id_(uint8_t *id);
   void init_display_();
-  void init_pixel_lut_();
-  void init_lut_landscape_();
-  void init_lut_portrait_();
+  /// Second half of the init sequence, after the sleep-out delay
+  void finish_init_();
+  /// Mark the panel as accepting commands and send any frame held back meanwhile
+  void panel_ready_();
   void write_display_();
-  void send_command_(uint8_t cmd);
-  void send_data_(uint8_t data);
+  uint32_t snapshot_geometry_() const;
+  bool resume_panel_();
+  void log_benchmark_(const char *name, uint32_t ops, uint32_t elapsed_us);
+  /// False if the content hash and watched entities say the last frame is still current
+  bool content_changed_();
+  /// update() past the render skipping check: render and queue the frame
+  void update_frame_();
+  /// Run the display lambda and record how long it took
+  void render_();
+  /// Restore the background under the previous overlay, then run the lambda as the new overlay
+  void render_over_background_();
+  /// Strip mode update: render and send the panel one strip of rows at a time
+  void update_strips_();
+#ifdef USE_SENSOR
+  void publish_stats_();
+#endif
+  /// Send the rendered frame now, or on the next TE edge when a TE pin is configured
+  void queue_write_();
+  static void te_isr_(ST7305RLCD *arg);
+  /// Turn the display back on and, with the governor, wake it and pick the refresh rate
+  void prepare_power_for_write_();
+  void run_power_governor_();
+  /// On the render task: record the request (dropping its opposite) for loop() and return true
+  bool defer_power_(uint8_t request, uint8_t opposite);
+  void apply_deferred_power_();
+  bool flush_step_();
+  /// Run the update or write that was held back while the frame was streaming
+  void flush_done_();
+  /// Send one chunk for the next async panel in line (called by the first registered panel)
+  static void run_flush_scheduler_();
+  void finish_write_();
+  void start_subframe_();
+  /// Run draw() with buffer_ pointing at the LSB bitplane (frame modulation)
+  template<typename F> void on_gray_plane_(F &&draw) {
+    uint8_t *msb = this->buffer_;
+    this->buffer_ = this->gray_plane_;
+    draw();
+    this->buffer_ = msb;
+  }
+  void write_window_(uint16_t row_first, uint16_t row_last, uint16_t col_first, uint16_t col_last);
+  void send_command_(uint8_t cmd, const uint8_t *data = nullptr, size_t len = 0);
+  void send_init_sequence_(const uint8_t *sequence);
 
   GPIOPin *dc_pin_{nullptr};
   GPIOPin *reset_pin_{nullptr};
+  InternalGPIOPin *te_pin_{nullptr};
 
   ST7305Model model_{ST7305_MODEL_WAVESHARE_400X300};
   ST7305Orientation orientation_{ST7305_ORIENTATION_LANDSCAPE};
   uint16_t width_{400};
   uint16_t height_{300};
   size_t buffer_size_{15000};
+  ST7305BufferMemory buffer_memory_{ST7305_BUFFER_MEMORY_AUTO};
+  bool buffer_external_{false};  ///< Where allocate_buffer_() put the main framebuffer
+  uint16_t block_stride_{75};  ///< Bytes per panel RAM row (blocks along the 4-pixel axis)
+  uint16_t buffer_rows_{200};  ///< Panel RAM rows held in the buffer
+  uint16_t panel_rows_{200};   ///< Panel RAM rows of the whole panel
+  // Strip mode: buffer_ holds panel RAM rows [strip_base_, strip_base_ + buffer_rows_)
+  uint16_t strip_rows_{0};
+  uint16_t strip_base_{0};
+
+  /// Read back the display ID at the configured rate and fall back to the safe rate on mismatch
+  bool verify_data_rate_{false};
+
+  // Pixel path specialized for the current orientation and rotation
+  void (ST7305RLCD::*pixel_fn_)(int, int, Color){nullptr};
+  ST7305DitherMode dither_{ST7305_DITHER_NONE};
+  display::DisplayRotation pixel_fn_rotation_{display::DISPLAY_ROTATION_0_DEGREES};
 
   // Address window parameters (panel-specific)
   uint8_t col_start_{0x12};
@@ -100,9 +583,139 @@ class ST7305RLCD : public display::DisplayBuffer,
   uint8_t row_start_{0x00};
   uint8_t row_end_{0xC7};
 
-  // Pixel coordinate lookup tables for O(1) buffer access
-  uint16_t *pixel_index_lut_{nullptr};
-  uint8_t *pixel_bit_lut_{nullptr};
+  // Panel electrical settings; gate_lines_ == 0 derives the value from height
+  const char *model_name_{"Custom"};
+  uint8_t gate_lines_{0};
+  uint8_t vshp_{0x69};
+  uint8_t vslp_{0x19};
+  uint8_t vshn_{0x4B};
+  uint8_t vsln_{0x19};
+  const uint8_t *timing_sequence_{ST7305_INIT_TIMING_DEFAULT};
+  /// True when the address window matches the buffer layout, so sub-windows can be addressed
+  bool partial_window_{false};
+
+  // Bounding box of bytes modified since the last write (empty when min > max)
+  uint16_t dirty_row_min_{0xFFFF};
+  uint16_t dirty_row_max_{0};
+  uint16_t dirty_col_min_{0xFFFF};
+  uint16_t dirty_col_max_{0};
+
+  // Shadow copy of panel RAM for diffing (diff_updates only)
+  bool diff_updates_{false};
+  uint8_t *shadow_buffer_{nullptr};
+  bool shadow_valid_{false};
+
+  // Asynchronous flush state, one chunk of rows is sent per loop()
+  bool async_flush_{false};
+  uint16_t flush_chunk_rows_{20};
+  bool flushing_{false};
+  bool update_pending_{false};
+  bool write_pending_{false};
+  uint16_t flush_row_first_{0};
+  uint16_t flush_row_next_{0};
+  uint16_t flush_row_last_{0};
+  uint16_t flush_col_first_{0};  ///< In column addresses
+  uint16_t flush_col_last_{0};
+
+  // Shared flush scheduler: async instances in setup order, and whose chunk goes next
+  static std::vector<ST7305RLCD *> flush_peers_;
+  static size_t flush_turn_;
+
+  // Double buffering: buffer_ is the back buffer drawn by the lambda,
+  // flush_buffer_ points at whichever buffer the panel is fed from
+  bool double_buffer_{false};
+  uint8_t *front_buffer_{nullptr};
+  uint8_t *flush_buffer_{nullptr};
+  HighFrequencyLoopRequester high_freq_;
+
+  // Render skipping: content_dirty_ is set by watched entities, the hash is compared per tick
+  std::function<uint32_t()> content_hash_;
+  uint32_t last_content_hash_{0};
+  bool watching_{false};
+  bool content_dirty_{true};
+  display::DisplayRotation content_rotation_{display::DISPLAY_ROTATION_0_DEGREES};
+
+  // Render task: render_state_ is the single-slot handoff of buffer_ between the task and loop()
+  bool render_task_enabled_{false};
+  std::atomic<uint8_t> render_state_{ST7305_RENDER_IDLE};
+  bool render_requested_{false};  ///< update() came while a frame was in flight
+  bool render_queued_{false};     ///< The READY frame was handed to queue_write_()
+  std::atomic<uint8_t> deferred_power_{0};  ///< ST7305DeferredPower bits set by the render task
+#ifdef USE_ESP32
+  TaskHandle_t render_task_{nullptr};
+  static void render_task_fn_(void *arg);
+#endif
+  /// True while running on the render task (not subscribed to the watchdog, no SPI)
+  bool on_render_task_() const;
+  /// Hand buffer_ to the render task
+  void start_render_();
+  /// Send the frame the render task finished, then give the buffer back
+  void take_rendered_frame_();
+
+  // Scroll area in user rows
+  int scroll_top_{0};
+  int scroll_height_{0};
+
+  // Frame modulation grayscale: buffer_ holds the MSB plane, gray_plane_ the LSB plane
+  bool frame_modulation_{false};
+  uint8_t *gray_plane_{nullptr};
+  uint32_t subframe_interval_{20};
+  uint32_t last_subframe_{0};
+  uint8_t subframe_{0};
+
+  // TE pacing: te_count_ is bumped from the ISR, te_seen_ is the last edge acted on
+  bool paced_updates_{false};
+  bool te_armed_{false};
+  uint32_t te_armed_at_{0};
+  volatile uint32_t te_count_{0};
+  uint32_t te_seen_{0};
+  uint32_t missed_vsyncs_{0};
+
+  // Power state as last commanded; init_display_() leaves the panel in high power
+  bool ready_{false};
+  bool write_when_ready_{false};
+  bool sleep_when_ready_{false};
+  bool sleeping_{false};
+  bool low_power_{false};
+  bool display_off_{false};
+  bool power_governor_{false};
+  uint32_t low_power_after_{0};
+  uint32_t sleep_after_{0};
+  uint32_t last_write_{0};
+
+  // Transfer statistics
+  uint32_t bytes_compared_{0};
+  uint32_t bytes_sent_{0};
+  uint32_t frames_skipped_{0};
+
+  bool benchmark_on_boot_{false};
+  display::display_writer_t background_writer_;
+  uint8_t *background_{nullptr};
+  bool background_valid_{false};
+  /// Region the lambda changed last frame, in panel RAM rows and byte columns
+  uint16_t overlay_row_min_{0xFFFF};
+  uint16_t overlay_row_max_{0};
+  uint16_t overlay_col_min_{0xFFFF};
+  uint16_t overlay_col_max_{0};
+  bool snapshot_{false};
+  bool snapshot_restored_{false};
+  bool resume_{false};
+  bool resumed_{false};
+
+  // Timing instrumentation, in CPU cycles
+  uint32_t pixel_calls_{0};
+  uint32_t render_cycles_{0};
+  uint32_t write_cycles_{0};        ///< Last completed frame
+  uint32_t frame_write_cycles_{0};  ///< Frame in flight
+
+#ifdef USE_SENSOR
+  sensor::Sensor *render_time_sensor_{nullptr};
+  sensor::Sensor *write_time_sensor_{nullptr};
+  sensor::Sensor *bytes_sent_sensor_{nullptr};
+  sensor::Sensor *frames_skipped_sensor_{nullptr};
+  sensor::Sensor *pixel_calls_sensor_{nullptr};
+  uint32_t stats_interval_{0};
+#endif
 };
 
 }  // namespace st7305_rlcd
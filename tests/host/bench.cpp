@@ -0,0 +1,103 @@
+/**
+ * @file bench.cpp
+ * @brief Host benchmark of the drawing paths
+ *
+ * Absolute numbers depend on the machine; the checks only cover ratios
+ * between the fast paths and per-pixel drawing of the same area, plus a
+ * generous ceiling for a full-screen Bayer dither.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "test_common.h"
+
+using namespace st7305_host;
+using esphome::COLOR_OFF;
+using esphome::COLOR_ON;
+using esphome::st7305_rlcd::ST7305RLCD;
+
+namespace {
+
+/// Best of a few runs of fn, in microseconds
+template<typename F> double best_us(F &&fn, int runs = 15) {
+  double best = 1e30;
+  for (int i = 0; i < runs; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    const double us = std::chrono::duration<double, std::micro>(end - start).count();
+    if (us < best)
+      best = us;
+  }
+  return best;
+}
+
+}  // namespace
+
+int main() {
+  reset();
+  Rig rig(esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300);
+  rig.boot();
+  ST7305RLCD &it = rig.display;
+  const int w = it.get_width(), h = it.get_height();
+
+  const double pixels = best_us([&] {
+    for (int y = 0; y < h; y++)
+      for (int x = 0; x < w; x++)
+        it.draw_pixel_at(x, y, COLOR_ON);
+  });
+  const double rect = best_us([&] { it.fill_rect(0, 0, w, h); });
+
+  std::vector<uint8_t> bits(static_cast<size_t>((w + 7) / 8) * h, 0xA5);
+  const double bitmap_pixels = best_us([&] {
+    for (int y = 0; y < h; y++)
+      for (int x = 0; x < w; x++)
+        it.draw_pixel_at(x, y, (bits[static_cast<size_t>(y) * ((w + 7) / 8) + x / 8] & (0x80 >> (x % 8))) ? COLOR_ON : COLOR_OFF);
+  });
+  const double bitmap = best_us([&] { it.draw_bitmap(0, 0, w, h, bits.data(), COLOR_ON, COLOR_OFF, false); });
+
+  std::vector<uint8_t> ramp(static_cast<size_t>(w) * h);
+  for (int y = 0; y < h; y++)
+    for (int x = 0; x < w; x++)
+      ramp[static_cast<size_t>(y) * w + x] = static_cast<uint8_t>((x + y) * 255 / (w + h - 2));
+  const double bayer = best_us([&] { it.draw_grayscale(0, 0, w, h, ramp.data()); });
+
+  // A screen of text, 8 x 10px cells
+  TestFont font;
+  std::string line;
+  while (static_cast<int>(line.size()) * 8 < w)
+    line += "AgW ";
+  const double text_pixels = best_us([&] {
+    for (int y = 0; y + 10 <= h; y += 10)
+      it.print(0, y, font.get(), COLOR_ON, esphome::display::TextAlign::TOP_LEFT, line.c_str());
+  });
+  const double text = best_us([&] {
+    for (int y = 0; y + 10 <= h; y += 10)
+      it.draw_text(0, y, font.get(), COLOR_ON, line.c_str());
+  });
+
+  const double frame = best_us(
+      [&] {
+        it.update();
+        rig.sync();
+      },
+      5);
+
+  printf("%dx%d, best of several runs:\n", w, h);
+  printf("  draw_pixel_at, full screen   %9.1f us\n", pixels);
+  printf("  fill_rect, full screen       %9.1f us  (%.1fx)\n", rect, pixels / rect);
+  printf("  opaque bitmap, per pixel    %9.1f us\n", bitmap_pixels);
+  printf("  draw_bitmap, opaque          %9.1f us  (%.1fx)\n", bitmap, bitmap_pixels / bitmap);
+  printf("  draw_grayscale, Bayer        %9.1f us\n", bayer);
+  printf("  text through Font::print    %9.1f us\n", text_pixels);
+  printf("  draw_text                    %9.1f us  (%.1fx)\n", text, text_pixels / text);
+  printf("  update() + recorded SPI      %9.1f us\n", frame);
+
+  CHECK(pixels / rect >= 4.0);
+  CHECK(bitmap_pixels / bitmap >= 1.3);
+  CHECK(text_pixels / text >= 1.2);
+  CHECK(bayer < 50000.0);
+  return finish("bench");
+}
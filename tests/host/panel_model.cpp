@@ -0,0 +1,150 @@
+#include "panel_model.h"
+
+#include <cstdio>
+
+namespace st7305_host {
+
+std::vector<Command> commands(const SpiRecorder &rec) {
+  std::vector<Command> result;
+  for (const SpiByte &byte : rec.bytes) {
+    if (byte.command) {
+      result.push_back({byte.value, {}, byte.time_ms});
+    } else if (!result.empty()) {
+      result.back().data.push_back(byte.value);
+    }
+  }
+  return result;
+}
+
+long Frame::diff(const Frame &other) const {
+  if (this->width != other.width || this->height != other.height)
+    return -1;
+  long count = 0;
+  for (size_t i = 0; i < this->pixels.size(); i++)
+    count += this->pixels[i] != other.pixels[i];
+  return count;
+}
+
+PanelModel::PanelModel(const esphome::st7305_rlcd::ST7305PanelProfile &profile)
+    : profile_(profile), ram_(static_cast<size_t>(COLUMNS) * 3 * ROWS, 0xFF) {}
+
+void PanelModel::apply(const std::vector<Command> &commands) {
+  for (const Command &cmd : commands) {
+    switch (cmd.code) {
+      case 0x2A:
+        if (cmd.data.size() >= 2)
+          this->col_start_ = cmd.data[0], this->col_end_ = cmd.data[1];
+        break;
+      case 0x2B:
+        if (cmd.data.size() >= 2)
+          this->row_start_ = cmd.data[0], this->row_end_ = cmd.data[1];
+        break;
+      case 0x2C: {
+        // Column by column along the window row, then on to the next row
+        const int row_bytes = (this->col_end_ - this->col_start_ + 1) * 3;
+        size_t index = 0;
+        for (uint8_t value : cmd.data) {
+          const int row = this->row_start_ + static_cast<int>(index / row_bytes);
+          const int byte = this->col_start_ * 3 + static_cast<int>(index % row_bytes);
+          index++;
+          if (row > this->row_end_)
+            break;
+          this->ram_[static_cast<size_t>(row) * COLUMNS * 3 + byte] = value;
+          this->ram_bytes_written_++;
+        }
+        break;
+      }
+      case 0x10:
+      case 0x11: {
+        const bool sleep = cmd.code == 0x10;
+        if (sleep != this->sleeping_) {
+          if (this->sleep_changed_ && cmd.time_ms - this->last_sleep_change_ < 120)
+            this->sleep_timing_violations_++;
+          this->sleep_changed_ = true;
+          this->last_sleep_change_ = cmd.time_ms;
+          this->sleeping_ = sleep;
+        }
+        break;
+      }
+      case 0x28:
+        this->display_on_ = false;
+        break;
+      case 0x29:
+        this->display_on_ = true;
+        break;
+      case 0x38:
+        this->low_power_ = false;
+        break;
+      case 0x39:
+        this->low_power_ = true;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+Frame PanelModel::frame() const {
+  const int width = this->profile_.width, height = this->profile_.height;
+  Frame frame(width, height);
+  const bool landscape = this->profile_.orientation == esphome::st7305_rlcd::ST7305_ORIENTATION_LANDSCAPE;
+  // Black = bit clear. Landscape: RAM row = x / 2, byte = (H-1-y) / 4. Portrait: RAM row = y / 2, byte = x / 4.
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int row, byte, bit;
+      if (landscape) {
+        const int inv_y = height - 1 - y;
+        row = x >> 1, byte = inv_y >> 2, bit = ((inv_y & 3) << 1) | (x & 1);
+      } else {
+        row = y >> 1, byte = x >> 2, bit = ((y & 1) << 2) | (x & 3);
+      }
+      const size_t index =
+          static_cast<size_t>(this->profile_.row_start + row) * COLUMNS * 3 + this->profile_.col_start * 3 + byte;
+      frame.set(x, y, !(this->ram_[index] & (0x80 >> bit)));
+    }
+  }
+  return frame;
+}
+
+bool write_pbm(const std::string &path, const Frame &frame) {
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr)
+    return false;
+  fprintf(file, "P4\n%d %d\n", frame.width, frame.height);
+  for (int y = 0; y < frame.height; y++) {
+    for (int x = 0; x < frame.width; x += 8) {
+      uint8_t byte = 0;
+      for (int bit = 0; bit < 8 && x + bit < frame.width; bit++)
+        byte |= frame.get(x + bit, y) ? 0x80 >> bit : 0;
+      fputc(byte, file);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+bool read_pbm(const std::string &path, Frame &frame) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr)
+    return false;
+  int width, height;
+  if (fscanf(file, "P4 %d %d", &width, &height) != 2 || fgetc(file) == EOF) {
+    fclose(file);
+    return false;
+  }
+  frame = Frame(width, height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x += 8) {
+      const int byte = fgetc(file);
+      if (byte == EOF) {
+        fclose(file);
+        return false;
+      }
+      for (int bit = 0; bit < 8 && x + bit < width; bit++)
+        frame.set(x + bit, y, byte & (0x80 >> bit));
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+}  // namespace st7305_host
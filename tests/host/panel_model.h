@@ -0,0 +1,94 @@
+/**
+ * @file panel_model.h
+ * @brief ST7305 model fed from the recorded SPI stream
+ *
+ * Replays commands the way the controller executes them: 0x2A/0x2B set the
+ * address window, 0x2C streams data into panel RAM row by row across that
+ * window (3 bytes per column address). The RAM content is decoded back into
+ * pixels with the block packing from the datasheet, independently of the
+ * driver's own addressing.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "esphome/core/hal.h"
+#include "host.h"
+#include "st7305_panels.h"
+
+namespace st7305_host {
+
+/// Drives the recorder's DC level, stands in for the dc_pin
+class DcPin : public esphome::GPIOPin {
+ public:
+  void digital_write(bool value) override { recorder().dc = value; }
+};
+
+/// A command byte and the data bytes that followed it
+struct Command {
+  uint8_t code;
+  std::vector<uint8_t> data;
+  uint32_t time_ms;
+};
+
+/// Group the recorded bytes into commands
+std::vector<Command> commands(const SpiRecorder &rec);
+
+/// 1-bit image, true = black, row-major
+struct Frame {
+  int width{0};
+  int height{0};
+  std::vector<bool> pixels;
+  Frame() = default;
+  Frame(int width, int height) : width(width), height(height), pixels(static_cast<size_t>(width) * height, false) {}
+  bool get(int x, int y) const { return this->pixels[static_cast<size_t>(y) * this->width + x]; }
+  void set(int x, int y, bool black) { this->pixels[static_cast<size_t>(y) * this->width + x] = black; }
+  bool operator==(const Frame &other) const {
+    return this->width == other.width && this->height == other.height && this->pixels == other.pixels;
+  }
+  /// Pixels that differ from other, -1 if the sizes differ
+  long diff(const Frame &other) const;
+};
+
+class PanelModel {
+ public:
+  static const int COLUMNS = 256;  ///< Column addresses (3 bytes each)
+  static const int ROWS = 256;     ///< Row addresses
+
+  explicit PanelModel(const esphome::st7305_rlcd::ST7305PanelProfile &profile);
+
+  /// Execute the recorded commands, in order
+  void apply(const std::vector<Command> &commands);
+
+  /// Pixels inside the profile's address window, decoded with the datasheet packing
+  Frame frame() const;
+
+  bool sleeping() const { return this->sleeping_; }
+  bool display_on() const { return this->display_on_; }
+  bool low_power() const { return this->low_power_; }
+  /// RAM bytes written by 0x2C commands, over all applied commands
+  uint32_t ram_bytes_written() const { return this->ram_bytes_written_; }
+  /// 0x10/0x11 sent less than 120ms after the opposite command
+  uint32_t sleep_timing_violations() const { return this->sleep_timing_violations_; }
+
+ protected:
+  esphome::st7305_rlcd::ST7305PanelProfile profile_;
+  std::vector<uint8_t> ram_;
+  uint8_t col_start_{0}, col_end_{COLUMNS - 1}, row_start_{0}, row_end_{ROWS - 1};
+  bool sleeping_{true};
+  bool display_on_{false};
+  bool low_power_{false};
+  bool sleep_changed_{false};
+  uint32_t last_sleep_change_{0};
+  uint32_t ram_bytes_written_{0};
+  uint32_t sleep_timing_violations_{0};
+};
+
+/// Binary PBM (P4) file I/O, black = 1 as in the format
+bool write_pbm(const std::string &path, const Frame &frame);
+bool read_pbm(const std::string &path, Frame &frame);
+
+}  // namespace st7305_host
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+struct Color {
+  union {
+    struct {
+      uint8_t r, g, b, w;
+    };
+    uint32_t raw_32;
+  };
+  constexpr Color() : raw_32(0) {}
+  constexpr Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t white = 0) : r(red), g(green), b(blue), w(white) {}
+  bool is_on() const { return this->raw_32 != 0; }
+};
+
+extern const Color COLOR_OFF;
+extern const Color COLOR_ON;
+
+namespace display {
+
+class Display;
+using display_writer_t = std::function<void(Display &)>;
+
+enum DisplayRotation {
+  DISPLAY_ROTATION_0_DEGREES = 0,
+  DISPLAY_ROTATION_90_DEGREES = 90,
+  DISPLAY_ROTATION_180_DEGREES = 180,
+  DISPLAY_ROTATION_270_DEGREES = 270,
+};
+
+enum class DisplayType {
+  DISPLAY_TYPE_BINARY = 1,
+  DISPLAY_TYPE_GRAYSCALE = 2,
+  DISPLAY_TYPE_COLOR = 3,
+};
+
+enum class TextAlign {
+  TOP = 0x00,
+  CENTER_VERTICAL = 0x01,
+  BASELINE = 0x02,
+  BOTTOM = 0x04,
+  LEFT = 0x00,
+  CENTER_HORIZONTAL = 0x08,
+  RIGHT = 0x10,
+  TOP_LEFT = TOP | LEFT,
+  TOP_CENTER = TOP | CENTER_HORIZONTAL,
+  TOP_RIGHT = TOP | RIGHT,
+  CENTER_LEFT = CENTER_VERTICAL | LEFT,
+  CENTER = CENTER_VERTICAL | CENTER_HORIZONTAL,
+  CENTER_RIGHT = CENTER_VERTICAL | RIGHT,
+  BASELINE_LEFT = BASELINE | LEFT,
+  BASELINE_CENTER = BASELINE | CENTER_HORIZONTAL,
+  BASELINE_RIGHT = BASELINE | RIGHT,
+  BOTTOM_LEFT = BOTTOM | LEFT,
+  BOTTOM_CENTER = BOTTOM | CENTER_HORIZONTAL,
+  BOTTOM_RIGHT = BOTTOM | RIGHT,
+};
+
+class BaseFont {
+ public:
+  virtual ~BaseFont() = default;
+  virtual void print(int x, int y, Display *display, Color color, const char *text, Color background) = 0;
+  virtual void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) = 0;
+};
+
+static const int16_t VALUE_NO_SET = 32766;
+
+struct Rect {
+  int16_t x{VALUE_NO_SET};
+  int16_t y{VALUE_NO_SET};
+  int16_t w{VALUE_NO_SET};
+  int16_t h{VALUE_NO_SET};
+  Rect() = default;
+  Rect(int16_t x, int16_t y, int16_t w, int16_t h) : x(x), y(y), w(w), h(h) {}
+  int16_t x2() const { return this->x + this->w; }
+  int16_t y2() const { return this->y + this->h; }
+  bool is_set() const { return this->h != VALUE_NO_SET && this->w != VALUE_NO_SET; }
+  bool inside(int16_t test_x, int16_t test_y, bool absolute = true) const {
+    if (!this->is_set())
+      return true;
+    return test_x >= this->x && test_x < this->x2() && test_y >= this->y && test_y < this->y2();
+  }
+};
+
+/// The subset of ESPHome's Display the driver builds on
+class Display : public PollingComponent {
+ public:
+  virtual void fill(Color color) {
+    for (int y = 0; y < this->get_height(); y++)
+      for (int x = 0; x < this->get_width(); x++)
+        this->draw_pixel_at(x, y, color);
+  }
+  void clear() { this->fill(COLOR_OFF); }
+  virtual void draw_pixel_at(int x, int y, Color color) = 0;
+  void horizontal_line(int x, int y, int width, Color color = COLOR_ON) {
+    for (int i = x; i < x + width; i++)
+      this->draw_pixel_at(i, y, color);
+  }
+  void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON) {
+    for (int i = y1; i < y1 + height; i++)
+      this->horizontal_line(x1, i, width, color);
+  }
+
+  int get_width() {
+    return this->rotation_ == DISPLAY_ROTATION_90_DEGREES || this->rotation_ == DISPLAY_ROTATION_270_DEGREES
+               ? this->get_height_internal()
+               : this->get_width_internal();
+  }
+  int get_height() {
+    return this->rotation_ == DISPLAY_ROTATION_90_DEGREES || this->rotation_ == DISPLAY_ROTATION_270_DEGREES
+               ? this->get_width_internal()
+               : this->get_height_internal();
+  }
+  void set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
+  DisplayRotation get_rotation() const { return this->rotation_; }
+
+  void set_writer(display_writer_t &&writer) { this->writer_ = writer; }
+  void set_auto_clear(bool auto_clear_enabled) { this->auto_clear_enabled_ = auto_clear_enabled; }
+
+  void start_clipping(Rect rect) { this->clipping_rectangle_.push_back(rect); }
+  void end_clipping() {
+    if (!this->clipping_rectangle_.empty())
+      this->clipping_rectangle_.pop_back();
+  }
+  Rect get_clipping() const { return this->clipping_rectangle_.empty() ? Rect() : this->clipping_rectangle_.back(); }
+  bool is_clipping() const { return !this->clipping_rectangle_.empty(); }
+
+  /// Text through the font's own renderer, as ESPHome's Display::print()
+  void print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text) {
+    int x_start, y_start, width, height;
+    this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+    font->print(x_start, y_start, this, color, text, COLOR_OFF);
+  }
+  void get_text_bounds(int x, int y, const char *text, BaseFont *font, TextAlign align, int *x1, int *y1, int *width,
+                       int *height) {
+    int x_offset, baseline;
+    font->measure(text, width, &x_offset, &baseline, height);
+    switch (static_cast<TextAlign>(static_cast<int>(align) & 0x18)) {
+      case TextAlign::RIGHT:
+        *x1 = x - *width;
+        break;
+      case TextAlign::CENTER_HORIZONTAL:
+        *x1 = x - (*width) / 2;
+        break;
+      default:
+        *x1 = x;
+        break;
+    }
+    switch (static_cast<TextAlign>(static_cast<int>(align) & 0x07)) {
+      case TextAlign::BOTTOM:
+        *y1 = y - *height;
+        break;
+      case TextAlign::BASELINE:
+        *y1 = y - baseline;
+        break;
+      case TextAlign::CENTER_VERTICAL:
+        *y1 = y - (*height) / 2;
+        break;
+      default:
+        *y1 = y;
+        break;
+    }
+  }
+
+  virtual DisplayType get_display_type() = 0;
+
+ protected:
+  virtual int get_width_internal() = 0;
+  virtual int get_height_internal() = 0;
+  void do_update_() {
+    if (this->auto_clear_enabled_)
+      this->clear();
+    if (this->writer_)
+      this->writer_(*this);
+  }
+
+  DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
+  display_writer_t writer_;
+  bool auto_clear_enabled_{true};
+  std::vector<Rect> clipping_rectangle_;
+};
+
+class DisplayBuffer : public Display {
+ public:
+  void draw_pixel_at(int x, int y, Color color) override {
+    if (!this->get_clipping().inside(x, y))
+      return;
+    switch (this->rotation_) {
+      case DISPLAY_ROTATION_0_DEGREES:
+        break;
+      case DISPLAY_ROTATION_90_DEGREES:
+        std::swap(x, y);
+        x = this->get_width_internal() - x - 1;
+        break;
+      case DISPLAY_ROTATION_180_DEGREES:
+        x = this->get_width_internal() - x - 1;
+        y = this->get_height_internal() - y - 1;
+        break;
+      case DISPLAY_ROTATION_270_DEGREES:
+        std::swap(x, y);
+        y = this->get_height_internal() - y - 1;
+        break;
+    }
+    this->draw_absolute_pixel_internal(x, y, color);
+  }
+
+ protected:
+  virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+
+  uint8_t *buffer_{nullptr};
+};
+
+}  // namespace display
+}  // namespace esphome
+
+#define LOG_DISPLAY(prefix, type, obj) \
+  do { \
+    (void) (obj); \
+  } while (0)
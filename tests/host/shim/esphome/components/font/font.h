@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace font {
+
+/// Glyph record as generated by ESPHome's font component; bitmap bits run on across rows
+struct GlyphData {
+  const uint8_t *a_char;
+  const uint8_t *data;
+  int advance;
+  int offset_x;
+  int offset_y;
+  int width;
+  int height;
+};
+
+class Glyph {
+ public:
+  Glyph(const GlyphData *data) : glyph_data_(data) {}
+  int match_length(const uint8_t *str) const {
+    const size_t length = strlen(reinterpret_cast<const char *>(this->glyph_data_->a_char));
+    return strncmp(reinterpret_cast<const char *>(str), reinterpret_cast<const char *>(this->glyph_data_->a_char),
+                   length) == 0
+               ? static_cast<int>(length)
+               : 0;
+  }
+  const GlyphData *get_glyph_data() const { return this->glyph_data_; }
+
+ protected:
+  const GlyphData *glyph_data_;
+};
+
+/**
+ * Font with ESPHome's rendering: print() reads the glyph bit stream and
+ * draws every set pixel through the display's draw_pixel_at().
+ */
+class Font : public display::BaseFont {
+ public:
+  Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1)
+      : baseline_(baseline), height_(height), bpp_(bpp) {
+    for (int i = 0; i < data_nr; i++)
+      this->glyphs_.emplace_back(&data[i]);
+  }
+
+  int match_next_glyph(const uint8_t *str, int *match_length) {
+    for (size_t i = 0; i < this->glyphs_.size(); i++) {
+      const int length = this->glyphs_[i].match_length(str);
+      if (length > 0) {
+        *match_length = length;
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  void print(int x_start, int y_start, display::Display *display, Color color, const char *text,
+             Color background) override {
+    int x_at = x_start;
+    const uint8_t *str = reinterpret_cast<const uint8_t *>(text);
+    while (*str != '\0') {
+      int match_length;
+      const int glyph_n = this->match_next_glyph(str, &match_length);
+      if (glyph_n < 0) {
+        if (!this->glyphs_.empty()) {
+          const int glyph_width = this->glyphs_[0].get_glyph_data()->width;
+          display->filled_rectangle(x_at, y_start, glyph_width, this->height_, color);
+          x_at += glyph_width;
+        }
+        str++;
+        continue;
+      }
+      const GlyphData *glyph = this->glyphs_[glyph_n].get_glyph_data();
+      const uint8_t *data = glyph->data;
+      uint8_t bitmask = 0, pixel_data = 0;
+      const uint8_t bpp_max = (1 << this->bpp_) - 1;
+      for (int y = y_start + glyph->offset_y; y != y_start + glyph->offset_y + glyph->height; y++) {
+        for (int x = x_at + glyph->offset_x; x != x_at + glyph->offset_x + glyph->width; x++) {
+          uint8_t pixel = 0;
+          for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
+            if (bitmask == 0) {
+              pixel_data = progmem_read_byte(data++);
+              bitmask = 0x80;
+            }
+            pixel <<= 1;
+            if ((pixel_data & bitmask) != 0)
+              pixel |= 1;
+            bitmask >>= 1;
+          }
+          // No blending in the shim, partial coverage rounds
+          if (pixel > bpp_max / 2)
+            display->draw_pixel_at(x, y, color);
+        }
+      }
+      x_at += glyph->advance;
+      str += match_length;
+    }
+  }
+
+  void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) override {
+    *baseline = this->baseline_;
+    *height = this->height_;
+    *x_offset = 0;
+    int x = 0;
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(str);
+    while (*s != '\0') {
+      int match_length;
+      const int glyph_n = this->match_next_glyph(s, &match_length);
+      if (glyph_n < 0) {
+        if (!this->glyphs_.empty())
+          x += this->glyphs_[0].get_glyph_data()->width;
+        s++;
+        continue;
+      }
+      x += this->glyphs_[glyph_n].get_glyph_data()->advance;
+      s += match_length;
+    }
+    *width = x;
+  }
+
+  const std::vector<Glyph> &get_glyphs() const { return this->glyphs_; }
+  int get_baseline() const { return this->baseline_; }
+  int get_height() const { return this->height_; }
+  uint8_t get_bpp() const { return this->bpp_; }
+
+ protected:
+  std::vector<Glyph> glyphs_;
+  int baseline_;
+  int height_;
+  uint8_t bpp_;
+};
+
+}  // namespace font
+}  // namespace esphome
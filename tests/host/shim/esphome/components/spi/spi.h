@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "host.h"
+
+namespace esphome {
+namespace spi {
+
+enum SPIBitOrder { BIT_ORDER_LSB_FIRST, BIT_ORDER_MSB_FIRST };
+enum SPIClockPolarity { CLOCK_POLARITY_LOW, CLOCK_POLARITY_HIGH };
+enum SPIClockPhase { CLOCK_PHASE_LEADING, CLOCK_PHASE_TRAILING };
+enum SPIDataRate : uint32_t {
+  DATA_RATE_1MHZ = 1000000,
+  DATA_RATE_10MHZ = 10000000,
+  DATA_RATE_20MHZ = 20000000,
+  DATA_RATE_40MHZ = 40000000,
+};
+
+class SPIClient {
+ public:
+  void set_data_rate(uint32_t data_rate) { this->data_rate_ = data_rate; }
+
+ protected:
+  uint32_t data_rate_{DATA_RATE_1MHZ};
+};
+
+/// Records every byte with the DC level set through the recorder's pin
+template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
+class SPIDevice : public SPIClient {
+ public:
+  void spi_setup() {}
+  void spi_teardown() {}
+  void enable() {
+    st7305_host::recorder().selected = true;
+    st7305_host::recorder().transactions++;
+  }
+  void disable() { st7305_host::recorder().selected = false; }
+  void write_byte(uint8_t data) {
+    st7305_host::SpiRecorder &rec = st7305_host::recorder();
+    rec.bytes.push_back({!rec.dc, data, st7305_host::now_ms()});
+  }
+  void write_array(const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++)
+      this->write_byte(data[i]);
+  }
+  /// MISO is not wired: reads return zeros
+  void read_array(uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++)
+      data[i] = 0;
+  }
+};
+
+}  // namespace spi
+}  // namespace esphome
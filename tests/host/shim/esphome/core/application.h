@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+
+class Application {
+ public:
+  void feed_wdt(uint32_t time = 0) { this->wdt_feeds_++; }
+  uint32_t get_wdt_feeds() const { return this->wdt_feeds_; }
+
+ protected:
+  uint32_t wdt_feeds_{0};
+};
+
+extern Application App;  // NOLINT
+
+}  // namespace esphome
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define IRAM_ATTR
+
+namespace esphome {
+
+namespace gpio {
+enum InterruptType : uint8_t {
+  INTERRUPT_RISING_EDGE = 1,
+  INTERRUPT_FALLING_EDGE = 2,
+  INTERRUPT_ANY_EDGE = 3,
+};
+}  // namespace gpio
+
+class GPIOPin {
+ public:
+  virtual ~GPIOPin() = default;
+  virtual void setup() {}
+  virtual void pin_mode(uint8_t flags) {}
+  virtual bool digital_read() { return false; }
+  virtual void digital_write(bool value) {}
+};
+
+class InternalGPIOPin : public GPIOPin {
+ public:
+  template<typename T> void attach_interrupt(void (*func)(T *), T *arg, gpio::InterruptType type) const {
+    this->isr_ = reinterpret_cast<void (*)(void *)>(func);
+    this->isr_arg_ = arg;
+  }
+  /// Host only: raise the interrupt as an edge on the pin would
+  void trigger() const {
+    if (this->isr_ != nullptr)
+      this->isr_(this->isr_arg_);
+  }
+
+ protected:
+  mutable void (*isr_)(void *){nullptr};
+  mutable void *isr_arg_{nullptr};
+};
+
+void delay(uint32_t ms);
+uint32_t millis();
+uint32_t micros();
+uint32_t arch_get_cpu_cycle_count();
+uint32_t arch_get_cpu_freq_hz();
+inline uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+}  // namespace esphome
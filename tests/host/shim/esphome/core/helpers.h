@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace esphome {
+
+/// Placement flags are accepted and ignored, the host has a single heap
+template<class T> class RAMAllocator {
+ public:
+  enum Flags : uint8_t {
+    NONE = 0,
+    ALLOC_EXTERNAL = 1 << 0,
+    ALLOC_INTERNAL = 1 << 1,
+    ALLOW_FAILURE = 1 << 2,
+  };
+  RAMAllocator() = default;
+  explicit RAMAllocator(uint8_t flags) : flags_(flags) {}
+  T *allocate(size_t n) { return static_cast<T *>(malloc(n * sizeof(T))); }
+  void deallocate(T *p, size_t n) { free(p); }
+
+ protected:
+  uint8_t flags_{ALLOC_INTERNAL | ALLOC_EXTERNAL};
+};
+template<class T> using ExternalRAMAllocator = RAMAllocator<T>;
+
+class HighFrequencyLoopRequester {
+ public:
+  void start() { this->started_ = true; }
+  void stop() { this->started_ = false; }
+  bool is_started() const { return this->started_; }
+
+ protected:
+  bool started_{false};
+};
+
+uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc = 0xffff, uint16_t reverse_poly = 0xa001,
+               bool refin = false, bool refout = false);
+uint32_t random_uint32();
+
+}  // namespace esphome
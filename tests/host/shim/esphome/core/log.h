@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdio>
+
+namespace esphome {
+/// Prints when ST7305_HOST_LOG is set in the environment
+void host_log_printf(const char *tag, const char *format, ...) __attribute__((format(printf, 2, 3)));
+}  // namespace esphome
+
+#define ESP_LOGE(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGCONFIG(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define ESP_LOGVV(tag, ...) ::esphome::host_log_printf(tag, __VA_ARGS__)
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define LOG_PIN(prefix, pin) \
+  do { \
+    (void) (pin); \
+  } while (0)
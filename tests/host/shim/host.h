@@ -0,0 +1,46 @@
+/**
+ * @file host.h
+ * @brief Controls of the host shim: fake clock, scheduler and SPI recorder
+ *
+ * The shim headers under esphome/ stand in for the parts of ESPHome the
+ * driver uses. Time only moves when a test advances it, so timeouts such as
+ * the 120ms sleep-out delay run deterministically.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace st7305_host {
+
+/// One byte on the bus; command bytes are sent with DC low
+struct SpiByte {
+  bool command;
+  uint8_t value;
+  uint32_t time_ms;
+};
+
+/// Everything the driver clocked out since the last clear()
+struct SpiRecorder {
+  std::vector<SpiByte> bytes;
+  bool dc{true};
+  bool selected{false};
+  uint32_t transactions{0};
+  void clear() {
+    this->bytes.clear();
+    this->transactions = 0;
+  }
+};
+
+SpiRecorder &recorder();
+
+/// Fake millis() clock
+uint32_t now_ms();
+/// Move the clock forward, running every timeout that falls due on the way
+void advance(uint32_t ms);
+/// Drop all scheduled timeouts and intervals and reset the clock
+void reset();
+
+}  // namespace st7305_host
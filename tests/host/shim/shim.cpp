@@ -0,0 +1,133 @@
+#include "host.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace st7305_host {
+
+namespace {
+
+struct Timer {
+  uint32_t due;
+  uint32_t interval;  ///< 0 for a timeout
+  std::function<void()> callback;
+};
+
+uint32_t clock_ms = 0;
+// Keyed by component and name, like the ESPHome scheduler
+std::map<std::pair<const esphome::Component *, std::string>, Timer> timers;
+
+}  // namespace
+
+SpiRecorder &recorder() {
+  static SpiRecorder instance;
+  return instance;
+}
+
+uint32_t now_ms() { return clock_ms; }
+
+void advance(uint32_t ms) {
+  const uint32_t target = clock_ms + ms;
+  while (true) {
+    // Earliest due timer up to the target; callbacks may schedule more
+    auto next = timers.end();
+    for (auto it = timers.begin(); it != timers.end(); ++it) {
+      if (it->second.due <= target && (next == timers.end() || it->second.due < next->second.due))
+        next = it;
+    }
+    if (next == timers.end())
+      break;
+    clock_ms = std::max(clock_ms, next->second.due);
+    std::function<void()> callback = next->second.callback;
+    if (next->second.interval != 0) {
+      next->second.due += next->second.interval;
+    } else {
+      timers.erase(next);
+    }
+    callback();
+  }
+  clock_ms = target;
+}
+
+void reset() {
+  timers.clear();
+  clock_ms = 0;
+  recorder().clear();
+}
+
+}  // namespace st7305_host
+
+namespace esphome {
+
+Application App;  // NOLINT
+
+const Color COLOR_OFF(0, 0, 0, 0);
+const Color COLOR_ON(255, 255, 255, 255);
+
+namespace setup_priority {
+const float HARDWARE = 800.0f;
+const float PROCESSOR = 400.0f;
+const float DATA = 600.0f;
+const float LATE = -100.0f;
+}  // namespace setup_priority
+
+Component::~Component() {
+  for (auto it = st7305_host::timers.begin(); it != st7305_host::timers.end();) {
+    it = it->first.first == this ? st7305_host::timers.erase(it) : std::next(it);
+  }
+}
+
+void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {
+  st7305_host::timers[{this, name}] = {st7305_host::clock_ms + timeout, 0, std::move(f)};
+}
+
+bool Component::cancel_timeout(const std::string &name) { return st7305_host::timers.erase({this, name}) != 0; }
+
+void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {
+  st7305_host::timers[{this, name}] = {st7305_host::clock_ms + interval, interval, std::move(f)};
+}
+
+bool Component::cancel_interval(const std::string &name) { return this->cancel_timeout(name); }
+
+void delay(uint32_t ms) { st7305_host::clock_ms += ms; }
+uint32_t millis() { return st7305_host::clock_ms; }
+uint32_t micros() { return st7305_host::clock_ms * 1000; }
+// The benchmark times with std::chrono; cycle counts only need to be monotonic here
+uint32_t arch_get_cpu_cycle_count() { return st7305_host::clock_ms * 240000; }
+uint32_t arch_get_cpu_freq_hz() { return 240000000; }
+
+uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc, uint16_t reverse_poly, bool refin, bool refout) {
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t i = 0; i < 8; i++)
+      crc = (crc & 1) ? (crc >> 1) ^ reverse_poly : crc >> 1;
+  }
+  return crc;
+}
+
+uint32_t random_uint32() { return static_cast<uint32_t>(rand()); }
+
+void host_log_printf(const char *tag, const char *format, ...) {
+  static const bool enabled = getenv("ST7305_HOST_LOG") != nullptr;
+  if (!enabled)
+    return;
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "[%s] ", tag);
+  vfprintf(stderr, format, args);
+  fputc('\n', stderr);
+  va_end(args);
+}
+
+}  // namespace esphome
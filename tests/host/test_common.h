@@ -0,0 +1,211 @@
+/**
+ * @file test_common.h
+ * @brief Shared pieces of the host tests: checks, a reference canvas and a test rig
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "panel_model.h"
+#include "esphome/components/font/font.h"
+#include "st7305_rlcd.h"
+
+namespace st7305_host {
+
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      ::st7305_host::failures()++; \
+    } \
+  } while (0)
+
+/// Exit code for main(): 0 when every CHECK passed
+inline int finish(const char *name) {
+  if (failures() == 0) {
+    printf("%s: all checks passed\n", name);
+    return 0;
+  }
+  printf("%s: %d check(s) failed\n", name, failures());
+  return 1;
+}
+
+/// 192x192 portrait panel whose window maps 1:1 onto the framebuffer (partial writes)
+constexpr esphome::st7305_rlcd::ST7305PanelProfile HOST_PROFILE_PORTRAIT_192X192 = {
+    "Host 192x192",
+    esphome::st7305_rlcd::ST7305_MODEL_CUSTOM,
+    192,
+    192,
+    esphome::st7305_rlcd::ST7305_ORIENTATION_PORTRAIT,
+    0x00,
+    0x0F,  // 16 columns * 3 bytes = 48 bytes = 192 / 4
+    0x00,
+    0x5F,  // 96 rows = 192 / 2
+    0x40,
+    0x69,
+    0x19,
+    0x4B,
+    0x19,
+    esphome::st7305_rlcd::ST7305_INIT_TIMING_DEFAULT,
+};
+
+/**
+ * Reference model of what a lambda draws: user coordinates go through the
+ * same rotation as ESPHome's DisplayBuffer::draw_pixel_at() into an absolute
+ * 1-bit frame, pixel by pixel.
+ */
+class Canvas {
+ public:
+  Canvas(int width, int height) : frame(width, height) {}
+  void set_rotation(esphome::display::DisplayRotation rotation) { this->rotation_ = rotation; }
+  int width() const { return this->swapped_() ? this->frame.height : this->frame.width; }
+  int height() const { return this->swapped_() ? this->frame.width : this->frame.height; }
+  void set_clip(int x, int y, int w, int h) { this->clip_x_ = x, this->clip_y_ = y, this->clip_w_ = w, this->clip_h_ = h; }
+  void clear_clip() { this->clip_w_ = -1; }
+
+  void pixel(int x, int y, bool black) {
+    if (this->clip_w_ >= 0 &&
+        (x < this->clip_x_ || x >= this->clip_x_ + this->clip_w_ || y < this->clip_y_ || y >= this->clip_y_ + this->clip_h_))
+      return;
+    const int w = this->frame.width, h = this->frame.height;
+    int ax = x, ay = y;
+    switch (this->rotation_) {
+      case esphome::display::DISPLAY_ROTATION_90_DEGREES:
+        ax = w - 1 - y, ay = x;
+        break;
+      case esphome::display::DISPLAY_ROTATION_180_DEGREES:
+        ax = w - 1 - x, ay = h - 1 - y;
+        break;
+      case esphome::display::DISPLAY_ROTATION_270_DEGREES:
+        ax = y, ay = h - 1 - x;
+        break;
+      default:
+        break;
+    }
+    if (ax >= 0 && ax < w && ay >= 0 && ay < h)
+      this->frame.set(ax, ay, black);
+  }
+  void fill_rect(int x, int y, int w, int h, bool black) {
+    for (int j = y; j < y + h; j++)
+      for (int i = x; i < x + w; i++)
+        this->pixel(i, j, black);
+  }
+  /// 1-bpp, MSB first, rows padded to bytes; clear bits drawn white unless transparent
+  void bitmap(int x, int y, int w, int h, const uint8_t *data, bool transparent) {
+    const int stride = (w + 7) / 8;
+    for (int j = 0; j < h; j++) {
+      for (int i = 0; i < w; i++) {
+        const bool set = data[j * stride + i / 8] & (0x80 >> (i % 8));
+        if (set || !transparent)
+          this->pixel(x + i, y + j, set);
+      }
+    }
+  }
+
+  Frame frame;
+
+ protected:
+  bool swapped_() const {
+    return this->rotation_ == esphome::display::DISPLAY_ROTATION_90_DEGREES ||
+           this->rotation_ == esphome::display::DISPLAY_ROTATION_270_DEGREES;
+  }
+  esphome::display::DisplayRotation rotation_{esphome::display::DISPLAY_ROTATION_0_DEGREES};
+  int clip_x_{0}, clip_y_{0}, clip_w_{-1}, clip_h_{0};
+};
+
+/// Small 1-bpp font packed like ESPHome's font component, glyphs drawn as ASCII art
+class TestFont {
+ public:
+  TestFont() {
+    this->add_("A", 1, 2, 7, {".###.", "#...#", "#...#", "#####", "#...#", "#...#", "#...#"});
+    this->add_("g", 0, 4, 6, {".####", "#...#", "#...#", ".####", "....#", "####."});
+    this->add_("W", 0, 2, 10, {"#...#...#", "#...#...#", "#...#...#", "#.#.#.#.#", "##.###.##", "#.....#..", "#.......#"});
+    this->add_("\xC3\xA9", 1, 1, 6, {"...#", "..#.", "....", ".##.", "#..#", "####", "#...", ".###"});  // e acute
+    this->add_(" ", 0, 0, 4, {});
+    std::vector<esphome::font::GlyphData> data;
+    for (const Entry &entry : this->entries_)
+      data.push_back({reinterpret_cast<const uint8_t *>(entry.utf8.c_str()), entry.bits.data(), entry.advance,
+                      entry.offset_x, entry.offset_y, entry.width, entry.height});
+    this->data_ = data;
+    this->font_ = std::make_unique<esphome::font::Font>(this->data_.data(), static_cast<int>(this->data_.size()), 8, 10);
+  }
+  esphome::font::Font *get() { return this->font_.get(); }
+
+ protected:
+  struct Entry {
+    std::string utf8;
+    std::vector<uint8_t> bits;
+    int advance, offset_x, offset_y, width, height;
+  };
+  void add_(const char *utf8, int offset_x, int offset_y, int advance, const std::vector<const char *> &rows) {
+    Entry entry{utf8, {}, advance, offset_x, offset_y, rows.empty() ? 0 : static_cast<int>(strlen(rows[0])),
+                static_cast<int>(rows.size())};
+    // One bit stream over all rows, no padding between them
+    int bit = 0;
+    for (const char *row : rows) {
+      for (const char *c = row; *c != '\0'; c++, bit++) {
+        if (bit % 8 == 0)
+          entry.bits.push_back(0);
+        if (*c == '#')
+          entry.bits.back() |= 0x80 >> (bit % 8);
+      }
+    }
+    this->entries_.push_back(entry);
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<esphome::font::GlyphData> data_;
+  std::unique_ptr<esphome::font::Font> font_;
+};
+
+/// A driver instance wired to the recorder, and the panel model replaying what it sent
+class Rig {
+ public:
+  explicit Rig(const esphome::st7305_rlcd::ST7305PanelProfile &profile) : model(profile) {
+    this->display.set_profile(profile);
+    this->display.set_dc_pin(&this->dc_);
+  }
+  /// setup() and the init sequence, up to the panel being ready
+  void boot() {
+    this->display.setup();
+    advance(250);
+    this->sync();
+  }
+  /// Run update() and loop() until an async flush is out, then replay the stream
+  void frame(std::function<void(esphome::st7305_rlcd::ST7305RLCD &)> &&draw) {
+    this->display.set_writer(
+        [draw](esphome::display::Display &it) { draw(static_cast<esphome::st7305_rlcd::ST7305RLCD &>(it)); });
+    this->display.update();
+    this->flush();
+  }
+  void flush() {
+    for (int i = 0; i < 10000; i++)
+      this->display.loop();
+    this->sync();
+  }
+  /// Feed everything recorded since the last call to the model; returns those commands
+  std::vector<Command> sync() {
+    std::vector<Command> cmds = commands(recorder());
+    this->model.apply(cmds);
+    recorder().clear();
+    return cmds;
+  }
+
+  esphome::st7305_rlcd::ST7305RLCD display;
+  PanelModel model;
+
+ protected:
+  DcPin dc_;
+};
+
+}  // namespace st7305_host
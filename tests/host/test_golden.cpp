@@ -0,0 +1,234 @@
+/**
+ * @file test_golden.cpp
+ * @brief Golden-frame tests: what reaches panel RAM matches a per-pixel reference, in every rotation
+ *
+ * Each scene is drawn through the driver's fast paths (fill_rect, draw_bitmap,
+ * clipping, draw_grayscale) and through the reference Canvas pixel by pixel.
+ * The frame decoded from the recorded 0x2C stream has to match the Canvas;
+ * for rotations 0 and 90 it also has to match the PBM files in golden/.
+ * Run with --update to rewrite those files after an intended change.
+ */
+
+#include <cstring>
+#include <string>
+
+#include "test_common.h"
+
+using namespace st7305_host;
+using esphome::COLOR_OFF;
+using esphome::COLOR_ON;
+using esphome::Color;
+using esphome::display::DisplayRotation;
+using esphome::st7305_rlcd::ST7305PanelProfile;
+using esphome::st7305_rlcd::ST7305RLCD;
+
+namespace {
+
+bool update_golden = false;
+
+// 13x5 arrow, MSB first, 2 bytes per row
+const uint8_t ARROW[] = {
+    0x00, 0x40, 0x00, 0x60, 0xFF, 0xF0, 0x00, 0x60, 0x00, 0x40,
+};
+
+const DisplayRotation ROTATIONS[] = {
+    esphome::display::DISPLAY_ROTATION_0_DEGREES,
+    esphome::display::DISPLAY_ROTATION_90_DEGREES,
+    esphome::display::DISPLAY_ROTATION_180_DEGREES,
+    esphome::display::DISPLAY_ROTATION_270_DEGREES,
+};
+
+/// The same scene on the driver and on the reference
+template<typename Target> void scene(Target &t, int w, int h) {
+  // Odd offsets and sizes, so no edge lands on a packing block boundary
+  t.rect(3, 5, 37, 23, true);
+  t.rect(11, 9, 9, 7, false);
+  // Clipped by the screen edges
+  t.rect(-4, h - 6, 15, 20, true);
+  t.rect(w - 9, -3, 30, 12, true);
+  // Lines and single pixels
+  t.rect(0, h / 2, w, 1, true);
+  t.rect(w / 3, 0, 1, h, true);
+  for (int i = 0; i < 40; i++)
+    t.pixel(50 + i, 60 + (i * 7) % 13, true);
+  // Bitmaps, transparent and opaque, one of them over black
+  t.bitmap(45, 33, 13, 5, ARROW, true);
+  t.bitmap(5, 9, 13, 5, ARROW, true);
+  t.bitmap(70, 20, 13, 5, ARROW, false);
+  t.bitmap(w - 7, h - 3, 13, 5, ARROW, false);
+  // Clipped fill
+  t.clip(100, 40, 21, 17);
+  t.rect(90, 30, 60, 60, true);
+  t.unclip();
+}
+
+struct DriverTarget {
+  ST7305RLCD &it;
+  Color on(bool black) { return black ? COLOR_ON : COLOR_OFF; }
+  void rect(int x, int y, int w, int h, bool black) { this->it.fill_rect(x, y, w, h, this->on(black)); }
+  void pixel(int x, int y, bool black) { this->it.draw_pixel_at(x, y, this->on(black)); }
+  void bitmap(int x, int y, int w, int h, const uint8_t *data, bool transparent) {
+    this->it.draw_bitmap(x, y, w, h, data, COLOR_ON, COLOR_OFF, transparent);
+  }
+  void clip(int x, int y, int w, int h) { this->it.start_clipping(esphome::display::Rect(x, y, w, h)); }
+  void unclip() { this->it.end_clipping(); }
+};
+
+struct CanvasTarget {
+  Canvas &c;
+  void rect(int x, int y, int w, int h, bool black) { this->c.fill_rect(x, y, w, h, black); }
+  void pixel(int x, int y, bool black) { this->c.pixel(x, y, black); }
+  void bitmap(int x, int y, int w, int h, const uint8_t *data, bool transparent) {
+    this->c.bitmap(x, y, w, h, data, transparent);
+  }
+  void clip(int x, int y, int w, int h) { this->c.set_clip(x, y, w, h); }
+  void unclip() { this->c.clear_clip(); }
+};
+
+std::string golden_path(const char *name) { return std::string(ST7305_GOLDEN_DIR) + "/" + name + ".pbm"; }
+
+void compare_golden(const char *name, const Frame &frame) {
+  const std::string path = golden_path(name);
+  if (update_golden) {
+    CHECK(write_pbm(path, frame));
+    return;
+  }
+  Frame golden;
+  if (!read_pbm(path, golden)) {
+    printf("%s: missing, run test_golden --update\n", path.c_str());
+    CHECK(false);
+    return;
+  }
+  const long diff = frame.diff(golden);
+  if (diff != 0)
+    printf("%s: %ld pixel(s) differ\n", name, diff);
+  CHECK(diff == 0);
+}
+
+void test_scene(const char *panel, const ST7305PanelProfile &profile) {
+  for (int r = 0; r < 4; r++) {
+    reset();
+    Rig rig(profile);
+    rig.display.set_rotation(ROTATIONS[r]);
+    rig.boot();
+    const int w = rig.display.get_width(), h = rig.display.get_height();
+
+    Canvas canvas(profile.width, profile.height);
+    canvas.set_rotation(ROTATIONS[r]);
+    CanvasTarget ref{canvas};
+    scene(ref, w, h);
+
+    rig.frame([w, h](ST7305RLCD &it) {
+      DriverTarget target{it};
+      scene(target, w, h);
+    });
+    const Frame frame = rig.model.frame();
+    const long diff = frame.diff(canvas.frame);
+    if (diff != 0)
+      printf("%s scene, rotation %d: %ld pixel(s) differ from the reference\n", panel, r * 90, diff);
+    CHECK(diff == 0);
+
+    if (r < 2) {
+      const std::string name = std::string(panel) + "_scene_" + std::to_string(r * 90);
+      compare_golden(name.c_str(), frame);
+    }
+  }
+}
+
+/// Ordered dither output has no per-pixel reference here; the golden file pins it
+void test_grayscale(const char *panel, const ST7305PanelProfile &profile) {
+  reset();
+  Rig rig(profile);
+  rig.boot();
+  const int w = rig.display.get_width(), h = rig.display.get_height();
+  std::vector<uint8_t> ramp(static_cast<size_t>(w) * h);
+  for (int y = 0; y < h; y++)
+    for (int x = 0; x < w; x++)
+      ramp[static_cast<size_t>(y) * w + x] = static_cast<uint8_t>(x * 255 / (w - 1));
+  rig.frame([&](ST7305RLCD &it) { it.draw_grayscale(0, 0, w, h, ramp.data()); });
+  const Frame frame = rig.model.frame();
+  // Left edge black, right edge white
+  CHECK(frame.get(0, h / 2));
+  CHECK(!frame.get(w - 1, h / 2));
+  compare_golden((std::string(panel) + "_bayer").c_str(), frame);
+}
+
+/// Partial windows have to reproduce the full frame, whichever rows changed
+void test_diff_sequence(const char *panel, const ST7305PanelProfile &profile) {
+  reset();
+  Rig rig(profile);
+  rig.display.set_diff_updates(true);
+  rig.boot();
+  const int w = rig.display.get_width(), h = rig.display.get_height();
+  for (int step = 0; step < 6; step++) {
+    Canvas canvas(profile.width, profile.height);
+    CanvasTarget ref{canvas};
+    ref.rect(step * 7, step * 5, 17, 11, true);
+    ref.rect(w - 20 - step * 3, h - 15, 9, 9, true);
+    rig.frame([=](ST7305RLCD &it) {
+      it.fill_rect(step * 7, step * 5, 17, 11);
+      it.fill_rect(w - 20 - step * 3, h - 15, 9, 9);
+    });
+    const long diff = rig.model.frame().diff(canvas.frame);
+    if (diff != 0)
+      printf("%s diff step %d: %ld pixel(s) differ\n", panel, step, diff);
+    CHECK(diff == 0);
+  }
+}
+
+/// draw_text() has to put the same pixels on the panel as Display::print() through the font
+void test_text(const char *panel, const ST7305PanelProfile &profile) {
+  TestFont font;
+  const char *text = "AgW\xC3\xA9 A?W";  // ? has no glyph
+  auto scene = [&font, text](ST7305RLCD &it, bool fast) {
+    const int w = it.get_width(), h = it.get_height();
+    auto print = [&](int x, int y, Color color, esphome::display::TextAlign align) {
+      if (fast) {
+        it.draw_text(x, y, font.get(), color, align, text);
+      } else {
+        it.print(x, y, font.get(), color, align, text);
+      }
+    };
+    print(3, 5, COLOR_ON, esphome::display::TextAlign::TOP_LEFT);
+    print(w / 2 + 1, h / 2, COLOR_ON, esphome::display::TextAlign::CENTER);
+    print(w + 3, h - 1, COLOR_ON, esphome::display::TextAlign::BOTTOM_RIGHT);  // Cut off by the edge
+    print(17, 41, COLOR_ON, esphome::display::TextAlign::BASELINE_LEFT);
+    it.fill_rect(0, 60, w, 14);
+    print(9, 61, COLOR_OFF, esphome::display::TextAlign::TOP_LEFT);
+    it.start_clipping(esphome::display::Rect(30, 80, 23, 6));
+    print(25, 78, COLOR_ON, esphome::display::TextAlign::TOP_LEFT);
+    it.end_clipping();
+  };
+  for (int r = 0; r < 4; r++) {
+    Frame frames[2];
+    for (int fast = 0; fast < 2; fast++) {
+      reset();
+      Rig rig(profile);
+      rig.display.set_rotation(ROTATIONS[r]);
+      rig.boot();
+      rig.frame([&](ST7305RLCD &it) { scene(it, fast != 0); });
+      frames[fast] = rig.model.frame();
+    }
+    const long diff = frames[1].diff(frames[0]);
+    if (diff != 0)
+      printf("%s text, rotation %d: %ld pixel(s) differ from Display::print()\n", panel, r * 90, diff);
+    CHECK(diff == 0);
+    if (r == 0)
+      compare_golden((std::string(panel) + "_text").c_str(), frames[1]);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  update_golden = argc > 1 && strcmp(argv[1], "--update") == 0;
+  test_scene("waveshare", esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300);
+  test_scene("portrait", HOST_PROFILE_PORTRAIT_192X192);
+  test_grayscale("waveshare", esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300);
+  test_grayscale("portrait", HOST_PROFILE_PORTRAIT_192X192);
+  test_diff_sequence("waveshare", esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300);
+  test_diff_sequence("portrait", HOST_PROFILE_PORTRAIT_192X192);
+  test_text("waveshare", esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300);
+  test_text("portrait", HOST_PROFILE_PORTRAIT_192X192);
+  return finish("test_golden");
+}
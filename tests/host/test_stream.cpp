@@ -0,0 +1,235 @@
+/**
+ * @file test_stream.cpp
+ * @brief Command stream tests: init sequence, address windows, partial and skipped writes, sleep timing
+ */
+
+#include "test_common.h"
+
+using namespace st7305_host;
+using esphome::COLOR_OFF;
+using esphome::COLOR_ON;
+using esphome::st7305_rlcd::ST7305_PROFILE_WAVESHARE_400X300;
+
+namespace {
+
+const Command *find(const std::vector<Command> &cmds, uint8_t code, size_t from = 0) {
+  for (size_t i = from; i < cmds.size(); i++) {
+    if (cmds[i].code == code)
+      return &cmds[i];
+  }
+  return nullptr;
+}
+
+size_t count(const std::vector<Command> &cmds, uint8_t code) {
+  size_t n = 0;
+  for (const Command &cmd : cmds)
+    n += cmd.code == code;
+  return n;
+}
+
+void test_init_sequence() {
+  reset();
+  Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.display.setup();
+  std::vector<Command> before = rig.sync();
+  // Sleep out goes first; the rest waits for the datasheet delay
+  CHECK(!before.empty() && before.back().code == 0x11);
+  CHECK(!rig.display.is_ready());
+  advance(250);
+  std::vector<Command> cmds = rig.sync();
+  CHECK(rig.display.is_ready());
+  const uint32_t sleep_out = before.back().time_ms;
+  for (const Command &cmd : cmds)
+    CHECK(cmd.time_ms - sleep_out >= 120);
+  // Full address window of the profile, display on
+  const Command *cols = find(cmds, 0x2A);
+  const Command *rows = find(cmds, 0x2B);
+  CHECK(cols != nullptr && cols->data == std::vector<uint8_t>({0x12, 0x2A}));
+  CHECK(rows != nullptr && rows->data == std::vector<uint8_t>({0x00, 0xC7}));
+  CHECK(!rig.model.sleeping());
+  CHECK(rig.model.display_on());
+}
+
+void test_full_and_partial_windows() {
+  reset();
+  Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.display.set_diff_updates(true);
+  rig.boot();
+
+  // First frame: whole window, 200 rows x 75 bytes
+  std::vector<Command> cmds;
+  rig.frame([](esphome::st7305_rlcd::ST7305RLCD &it) { it.fill_rect(10, 10, 50, 20); });
+  cmds = commands(recorder());
+  CHECK(rig.model.ram_bytes_written() == 15000);
+
+  // One small change: the window shrinks to the changed RAM rows and column addresses
+  const uint32_t written = rig.model.ram_bytes_written();
+  rig.display.set_writer([](esphome::display::Display &it) {
+    static_cast<esphome::st7305_rlcd::ST7305RLCD &>(it).fill_rect(10, 10, 50, 20);
+    it.draw_pixel_at(201, 150, COLOR_ON);
+  });
+  rig.display.update();
+  cmds = rig.sync();
+  const Command *cols = find(cmds, 0x2A);
+  const Command *rows = find(cmds, 0x2B);
+  const Command *data = find(cmds, 0x2C);
+  CHECK(cols != nullptr && rows != nullptr && data != nullptr);
+  if (cols != nullptr && rows != nullptr && data != nullptr) {
+    // x = 201 is RAM row 100; landscape bytes count from the bottom: (299 - 150) / 4 = 37 -> column 12
+    CHECK(rows->data == std::vector<uint8_t>({100, 100}));
+    CHECK(cols->data == std::vector<uint8_t>({0x12 + 12, 0x12 + 12}));
+    CHECK(data->data.size() == 3);
+  }
+  CHECK(rig.model.ram_bytes_written() - written == 3);
+  CHECK(rig.model.frame().get(201, 150));
+
+  // Same frame again: nothing written at all
+  rig.display.update();
+  cmds = rig.sync();
+  CHECK(count(cmds, 0x2C) == 0);
+  CHECK(rig.display.get_frames_skipped() >= 1);
+}
+
+void test_sleep_wake_timing() {
+  reset();
+  Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.boot();
+  rig.frame([](esphome::st7305_rlcd::ST7305RLCD &it) { it.fill_rect(0, 0, 20, 20); });
+  advance(200);
+  rig.display.sleep();
+  advance(200);
+  rig.display.wake();
+  // Drawn during the sleep-out delay: held back, then sent
+  rig.display.set_writer([](esphome::display::Display &it) {
+    static_cast<esphome::st7305_rlcd::ST7305RLCD &>(it).fill_rect(0, 0, 20, 20);
+    it.draw_pixel_at(300, 200, COLOR_ON);
+  });
+  rig.display.update();
+  std::vector<Command> cmds = rig.sync();
+  CHECK(count(cmds, 0x2C) == 0);
+  advance(150);
+  rig.flush();
+  CHECK(rig.model.frame().get(300, 200) && rig.model.frame().get(0, 0));
+  CHECK(!rig.model.sleeping());
+  CHECK(rig.model.sleep_timing_violations() == 0);
+}
+
+void test_sleep_while_not_ready() {
+  // During init: Sleep In waits until the init sequence is out
+  reset();
+  {
+    Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+    rig.display.setup();
+    rig.display.sleep();
+    std::vector<Command> cmds = rig.sync();
+    CHECK(count(cmds, 0x10) == 0);
+    advance(250);
+    cmds = rig.sync();
+    CHECK(!cmds.empty() && cmds.back().code == 0x10);
+    CHECK(rig.model.sleeping());
+    CHECK(rig.display.is_sleeping());
+    CHECK(rig.model.sleep_timing_violations() == 0);
+  }
+
+  // Right after Sleep Out: sent once the 120ms have passed, not straight away
+  reset();
+  {
+    Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+    rig.boot();
+    advance(200);
+    rig.display.sleep();
+    advance(200);
+    rig.display.wake();
+    rig.sync();
+    advance(10);
+    rig.display.sleep();
+    std::vector<Command> cmds = rig.sync();
+    CHECK(count(cmds, 0x10) == 0);
+    advance(150);
+    rig.sync();
+    CHECK(rig.model.sleeping());
+    CHECK(rig.model.sleep_timing_violations() == 0);
+  }
+
+  // sleep() then wake() before the panel is ready: stays awake
+  reset();
+  {
+    Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+    rig.display.setup();
+    rig.display.sleep();
+    rig.display.wake();
+    advance(250);
+    std::vector<Command> cmds = rig.sync();
+    CHECK(count(cmds, 0x10) == 0);
+    CHECK(!rig.model.sleeping());
+    CHECK(rig.display.is_ready());
+  }
+}
+
+void test_display_off_on() {
+  reset();
+  Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.boot();
+  rig.display.display_off();
+  rig.sync();
+  CHECK(!rig.model.display_on());
+  // The next frame turns the panel back on before it is sent
+  rig.frame([](esphome::st7305_rlcd::ST7305RLCD &it) { it.fill_rect(0, 0, 8, 8); });
+  CHECK(rig.model.display_on());
+  CHECK(rig.model.frame().get(3, 3));
+}
+
+void test_resume_display_off() {
+  reset();
+  {
+    Rig before(ST7305_PROFILE_WAVESHARE_400X300);
+    before.display.set_resume(true);
+    before.boot();
+    before.display.display_off();
+    before.display.on_shutdown();
+  }
+  reset();
+  Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.display.set_resume(true);
+  rig.display.setup();
+  CHECK(rig.display.is_resumed());
+  // The panel kept its registers (the model starts with the display off): no reset, no Display On yet
+  std::vector<Command> cmds = rig.sync();
+  CHECK(count(cmds, 0x29) == 0);
+  rig.frame([](esphome::st7305_rlcd::ST7305RLCD &it) { it.fill_rect(0, 0, 8, 8); });
+  CHECK(rig.model.display_on());
+  CHECK(rig.model.frame().get(3, 3));
+}
+
+void test_async_chunks() {
+  reset();
+  // Async panels join a static scheduler list, so this rig lives for the whole run
+  static Rig rig(ST7305_PROFILE_WAVESHARE_400X300);
+  rig.display.set_async_flush(true);
+  rig.display.set_flush_chunk_rows(25);
+  rig.boot();
+  rig.display.set_writer([](esphome::display::Display &it) {
+    static_cast<esphome::st7305_rlcd::ST7305RLCD &>(it).fill_rect(0, 0, 400, 300);
+  });
+  rig.display.update();
+  // Streamed from loop(): nothing but the window is out before the first pass
+  std::vector<Command> cmds = commands(recorder());
+  CHECK(count(cmds, 0x2C) == 0);
+  rig.flush();
+  CHECK(rig.model.ram_bytes_written() == 15000);
+  Frame frame = rig.model.frame();
+  CHECK(frame.get(0, 0) && frame.get(399, 299) && frame.get(200, 150));
+}
+
+}  // namespace
+
+int main() {
+  test_init_sequence();
+  test_full_and_partial_windows();
+  test_sleep_wake_timing();
+  test_sleep_while_not_ready();
+  test_display_off_on();
+  test_resume_display_off();
+  test_async_chunks();
+  return finish("test_stream");
+}
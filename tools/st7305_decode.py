@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Decode an ST7305 RLCD framebuffer dump into a PNG.
+
+The input is an ESPHome log containing the output of dump_framebuffer():
+a header line ``FB <L|P> <width> <height> <stride> <rows>``, hex data lines
+``FB <offset> <hex>`` and a final ``FB END``. Everything else on the line
+(timestamps, tags, colors) is ignored, so a log can be piped in as is:
+
+    esphome logs device.yaml | python3 tools/st7305_decode.py -o frame.png
+
+Pixel packing per panel RAM row (black = bit clear):
+  Landscape (2x4 blocks): row = x / 2, byte = (H - 1 - y) / 4,
+      bit = 7 - (((H - 1 - y) % 4) * 2 + x % 2)
+  Portrait (4x2 blocks):  row = y / 2, byte = x / 4,
+      bit = 7 - ((y % 2) * 4 + x % 4)
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+HEADER_RE = re.compile(r"FB ([LP]) (\d+) (\d+) (\d+) (\d+)")
+DATA_RE = re.compile(r"FB (\d{5}) ([0-9A-F]+)")
+
+
+def parse_dump(lines):
+    """Return (orientation, width, height, stride, buffer) from the last complete dump."""
+    header = None
+    data = None
+    result = None
+    for line in lines:
+        if (match := HEADER_RE.search(line)) is not None:
+            header = (match.group(1),) + tuple(int(g) for g in match.groups()[1:])
+            data = bytearray(header[3] * header[4])
+        elif header is not None and (match := DATA_RE.search(line)) is not None:
+            offset = int(match.group(1))
+            chunk = bytes.fromhex(match.group(2))
+            data[offset : offset + len(chunk)] = chunk
+        elif header is not None and "FB END" in line:
+            result = header[:4] + (bytes(data),)
+            header = None
+    if result is None:
+        raise ValueError("no complete framebuffer dump found")
+    return result
+
+
+def decode(orientation, width, height, stride, buffer):
+    """Unpack the framebuffer into rows of pixels, True = black."""
+    pixels = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            if orientation == "L":
+                inv_y = height - 1 - y
+                index = (x >> 1) * stride + (inv_y >> 2)
+                mask = 0x80 >> (((inv_y & 3) << 1) | (x & 1))
+            else:
+                index = (y >> 1) * stride + (x >> 2)
+                mask = 0x80 >> (((y & 1) << 2) | (x & 3))
+            row.append(not buffer[index] & mask)
+        pixels.append(row)
+    return pixels
+
+
+def write_png(path, pixels):
+    """Write a 1-bit grayscale PNG, black pixels as 0."""
+    height = len(pixels)
+    width = len(pixels[0]) if height else 0
+    raw = bytearray()
+    for row in pixels:
+        raw.append(0)  # Filter: none
+        for x in range(0, width, 8):
+            byte = 0
+            for bit, black in enumerate(row[x : x + 8]):
+                if not black:
+                    byte |= 0x80 >> bit
+            raw.append(byte)
+
+    def chunk(tag, payload):
+        body = tag + payload
+        return struct.pack(">I", len(payload)) + body + struct.pack(">I", zlib.crc32(body))
+
+    with open(path, "wb") as out:
+        out.write(b"\x89PNG\r\n\x1a\n")
+        out.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 1, 0, 0, 0, 0)))
+        out.write(chunk(b"IDAT", zlib.compress(bytes(raw), 9)))
+        out.write(chunk(b"IEND", b""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", nargs="?", help="log file (default: stdin)")
+    parser.add_argument("-o", "--output", default="framebuffer.png", help="PNG to write")
+    args = parser.parse_args()
+
+    source = open(args.log, encoding="utf-8", errors="replace") if args.log else sys.stdin
+    with source:
+        orientation, width, height, stride, buffer = parse_dump(source)
+    write_png(args.output, decode(orientation, width, height, stride, buffer))
+    print(f"{width}x{height} {'landscape' if orientation == 'L' else 'portrait'} -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()